@@ -107,6 +107,30 @@ enum {
     IKSTR_TYPE_BITS = 3,
 };
 
+/**
+ * Flag bits stored in the flags byte above IKSTR_TYPE_MASK.
+ *
+ * - IKSTR_FLAG_BORROWED: the memory behind the string is owned by someone else
+ *   (e.g. an `ikstr_arena` or an `ikstr_small` buffer). `ikstr_free` ignores such strings, and growing one
+ *   through the regular API moves it into a fresh heap allocation, after which
+ *   it is a regular ikstr that must be freed with `ikstr_free`.
+ * - IKSTR_FLAG_SHARED: the string carries an extension in front of its header
+ *   with a reference count (see `ikstr_share`) and room for a cached hash
+ *   (see `ikstr_cache_hash`). Every modifying function first replaces a
+ *   string that has other references with a private copy.
+ * - IKSTR_FLAG_HASHED: the extension holds the hash of the current content.
+ *   Cleared by every modifying function.
+ * - IKSTR_FLAG_MAPPED: the content is a read-only memory mapping of a file
+ *   (see `ikstr_map_file`). Every modifying function first replaces it with
+ *   a heap copy; `ikstr_free` unmaps it.
+ */
+enum {
+    IKSTR_FLAG_BORROWED = 1 << IKSTR_TYPE_BITS,
+    IKSTR_FLAG_SHARED   = 1 << (IKSTR_TYPE_BITS + 1),
+    IKSTR_FLAG_HASHED   = 1 << (IKSTR_TYPE_BITS + 2),
+    IKSTR_FLAG_MAPPED   = 1 << (IKSTR_TYPE_BITS + 3),
+};
+
 #define IKSTR_HDR_VAR(T, s) struct ikstrhdr##T *shdr = (void*)((s) - sizeof(struct ikstrhdr##T));
 #define IKSTR_HDR(T, s) ((struct ikstrhdr##T *)((s) - (sizeof(struct ikstrhdr##T))))
 
@@ -194,6 +218,7 @@ static inline size_t ikstr_avail(ikstr s) {
  */
 static inline void ikstr_set_len(ikstr s, size_t new_len) {
     unsigned char flags = s[-1]; // get Flags
+    if (flags & IKSTR_FLAG_HASHED) s[-1] = (char)(flags & ~IKSTR_FLAG_HASHED);
     switch (flags & IKSTR_TYPE_MASK) {
         case IKSTR_8:
             IKSTR_HDR(8,s)->len = new_len;
@@ -227,6 +252,7 @@ static inline void ikstr_set_len(ikstr s, size_t new_len) {
  */
 static inline void ikstr_inc_len(ikstr s, size_t inc) {
     unsigned char flags = s[-1]; // get Flags
+    if (flags & IKSTR_FLAG_HASHED) s[-1] = (char)(flags & ~IKSTR_FLAG_HASHED);
     switch (flags & IKSTR_TYPE_MASK) {
         case IKSTR_8:
             IKSTR_HDR(8,s)->len += inc;
@@ -352,6 +378,83 @@ IKSTR_API ikstr ikstr_empty(void);
  */
 IKSTR_API ikstr ikstr_new(const char *init);
 
+/**
+ * Creates a new `ikstr` meant to grow large, with the widest header type.
+ *
+ * Regular strings start with the smallest header that fits their length and
+ * must be copied into a new block whenever growth crosses 255 or 65535 bytes
+ * (the header gets wider, so the payload moves). A growable string spends a
+ * few more header bytes up front and is always resized in place by the
+ * allocator instead. Growth never narrows a header, only
+ * `ikstr_shrink_to_fit` does.
+ *
+ * @param init Pointer to the initial content, `IKSTR_NO_INIT`, or NULL, with
+ *             the same meaning as for `ikstr_new_len`.
+ * @param init_len The length of the initial content.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_new_growable_len(const void *init, size_t init_len);
+
+/**
+ * Same as `ikstr_new_growable_len` for a null-terminated C string.
+ *
+ * @param init The initial content. If NULL, the string starts empty.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_new_growable(const char *init);
+
+/**
+ * Size in bytes of an `ikstr_small` buffer (one cache line).
+ */
+#define IKSTR_SMALL_SIZE 64
+
+/**
+ * Largest length an `ikstr_small` can hold before spilling to the heap.
+ */
+#define IKSTR_SMALL_CAP (IKSTR_SMALL_SIZE - sizeof(struct ikstrhdr8) - 1)
+
+/**
+ * Inline storage for short strings.
+ *
+ * An `ikstr_small` embeds an `ikstrhdr8` header and up to `IKSTR_SMALL_CAP`
+ * bytes of payload, so it can live on the stack or inside another struct.
+ * The `ikstr` obtained from `ikstr_small_new_len` is marked with
+ * `IKSTR_FLAG_BORROWED` and works with every function of the library. As long
+ * as it fits, it stays in the buffer; once `ikstr_make_room_for` needs more
+ * space it spills into a regular heap string. Calling `ikstr_free` is always
+ * correct: it does nothing while the string is still inline.
+ *
+ * The buffer must outlive every use of the string that still points into it.
+ */
+typedef struct ikstr_small {
+    _Alignas(IKSTR_SMALL_SIZE) char buf[IKSTR_SMALL_SIZE];
+} ikstr_small;
+
+/**
+ * Creates an `ikstr` inside the given small-string buffer.
+ *
+ * Behaves like `ikstr_new_len`, including the handling of NULL and
+ * `IKSTR_NO_INIT` for `init`. If `init_len` exceeds `IKSTR_SMALL_CAP`, a regular
+ * heap string is returned instead.
+ *
+ * @param sm The buffer to place the string in. Must not be NULL.
+ * @param init Pointer to the initial content, NULL for zero-initialized
+ *             content, or `IKSTR_NO_INIT` for uninitialized content.
+ * @param init_len The length of the initial content.
+ * @return The new `ikstr`, or NULL if a heap allocation was needed and failed.
+ */
+IKSTR_API ikstr ikstr_small_new_len(ikstr_small *sm, const void *init, size_t init_len);
+
+/**
+ * Creates an `ikstr` inside the given small-string buffer from a C string.
+ *
+ * @param sm The buffer to place the string in. Must not be NULL.
+ * @param init The null-terminated C string to copy. If NULL, an empty string
+ *             is created.
+ * @return The new `ikstr`, or NULL if a heap allocation was needed and failed.
+ */
+IKSTR_API ikstr ikstr_small_new(ikstr_small *sm, const char *init);
+
 /**
  * Creates a duplicate of the given `ikstr` instance.
  *
@@ -373,12 +476,102 @@ IKSTR_API ikstr ikstr_dup(ikstr s);
  * This function releases the dynamically allocated memory of an `ikstr` instance,
  * including its metadata and string content. The function ensures proper deallocation
  * by accounting for the internal header structure associated with the `ikstr`.
+ * For a shared string it drops one reference, and the memory is released with
+ * the last one.
  *
  * @param s The `ikstr` instance to be freed. If the pointer is NULL, the function performs
  *          no operations.
  */
 IKSTR_API void ikstr_free(ikstr s);
 
+/**
+ * Returns a new reference to the content of a string, without copying it.
+ *
+ * The first call turns `*s` into a shared string, which moves it into a new
+ * allocation with room for a reference count (`*s` is updated; arena and
+ * `ikstr_small` strings end up on the heap). From then on every call is O(1)
+ * and only increments the count.
+ *
+ * All references are equal: each one is freed with `ikstr_free` (or
+ * `ikstr_release`), and modifying one through any function of the library
+ * first gives it a private copy (copy-on-write), so the others never see the
+ * change. Reference counts are updated atomically, so references may be
+ * handed to other threads; the content itself must not be modified through
+ * `ikstr_set_len`, `ikstr_inc_len` or direct writes while it is shared.
+ *
+ * @param s Pointer to the `ikstr` to share. Must not be NULL and must point to
+ *          a valid `ikstr`.
+ * @return The new reference (equal to the updated `*s`), or NULL if turning
+ *         `*s` into a shared string failed, in which case `*s` is unchanged.
+ */
+IKSTR_API ikstr ikstr_share(ikstr *s);
+
+/**
+ * Takes one more reference to a shared string.
+ *
+ * @param s A shared `ikstr` (one returned by `ikstr_share`). For any other
+ *          string the call is a no-op.
+ * @return `s`.
+ */
+IKSTR_API ikstr ikstr_retain(ikstr s);
+
+/**
+ * Drops one reference to a string. Equivalent to `ikstr_free`.
+ *
+ * @param s The `ikstr` to release. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_release(ikstr s);
+
+/**
+ * Returns the number of references to a string.
+ *
+ * @param s A valid `ikstr`.
+ * @return The reference count of a shared string, 1 for any other string.
+ */
+IKSTR_API size_t ikstr_refcount(ikstr s);
+
+/**
+ * Computes a 64-bit hash of `len` bytes.
+ *
+ * The hash is wyhash: fast on short keys, three independent multiply lanes
+ * on long ones, and well distributed in all 64 bits. It is not seeded and not
+ * meant to resist collision attacks. The value is the same for the same bytes
+ * within a process, and equal to `ikstr_hash` of an `ikstr` with that content.
+ *
+ * @param p The bytes to hash. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return The hash.
+ */
+IKSTR_API uint64_t ikstr_hash_len(const void *p, size_t len);
+
+/**
+ * Returns the hash of an `ikstr`, as computed by `ikstr_hash_len`.
+ *
+ * For strings with an extension (shared, interned, or passed through
+ * `ikstr_cache_hash`) the hash is cached in the extension, so only the first
+ * call after a modification reads the content. The cache is only written
+ * while the caller holds the sole reference; strings with several references
+ * are hashed without caching unless their hash was cached before sharing.
+ *
+ * @param s A valid `ikstr`.
+ * @return The hash.
+ */
+IKSTR_API uint64_t ikstr_hash(ikstr s);
+
+/**
+ * Computes the hash of a string and caches it.
+ *
+ * Strings without an extension are moved into a new allocation that has one
+ * (like `ikstr_share`, `s` is then invalid and the returned pointer must be
+ * used instead). Call it once on keys that will be hashed repeatedly, e.g.
+ * before inserting them into a hash map or sharing them.
+ *
+ * @param s A valid `ikstr`.
+ * @return The string with its hash cached, or NULL if the allocation fails,
+ *         in which case `s` is unchanged.
+ */
+IKSTR_API ikstr ikstr_cache_hash(ikstr s);
+
 /**
  * Ensures that the given `ikstr` instance has enough capacity to hold at least
  * the specified length, expanding it if necessary.
@@ -492,8 +685,12 @@ IKSTR_API ikstr ikstr_copy(ikstr s, const char* t);
  *
  * This function formats a string using the specified format (`fmt`) and the
  * variable argument list (`ap`), then concatenates the resulting formatted
- * string to the given `ikstr` instance. If necessary, memory is allocated to
- * accommodate the new content.
+ * string to the given `ikstr` instance. Formats without `%s` conversions
+ * are formatted directly into the free space of `s`; only if the text does
+ * not fit is `s` grown once and the formatting repeated. Formats with `%s`
+ * conversions are formatted into a temporary buffer first, so their string
+ * arguments may point into `s` (e.g. `ikstr_concat_fmt(s, "%s|%s", s, s)`).
+ * Other pointer arguments (`%n`) must not point into `s`.
  *
  * @param s The `ikstr` instance to which the formatted string will be
  *          concatenated. This pointer must be valid and point to a properly
@@ -510,6 +707,54 @@ IKSTR_API ikstr ikstr_copy(ikstr s, const char* t);
  */
 IKSTR_API ikstr ikstr_concat_vfmt(ikstr s, const char* fmt, va_list ap);
 
+/**
+ * Appends the decimal representation of a signed integer.
+ *
+ * Equivalent to `ikstr_concat_fmt(s, "%lld", v)` without going through printf.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param v The value to append.
+ * @return The updated `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_concat_int(ikstr s, long long v);
+
+/**
+ * Appends the decimal representation of an unsigned integer.
+ *
+ * Equivalent to `ikstr_concat_fmt(s, "%llu", v)` without going through printf.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param v The value to append.
+ * @return The updated `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_concat_uint(ikstr s, unsigned long long v);
+
+/**
+ * Appends the lowercase hexadecimal representation of an unsigned integer,
+ * without prefix.
+ *
+ * Equivalent to `ikstr_concat_fmt(s, "%llx", v)` without going through printf.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param v The value to append.
+ * @return The updated `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_concat_hex(ikstr s, unsigned long long v);
+
+/**
+ * Appends a double with a fixed number of decimals.
+ *
+ * Produces the same text as `ikstr_concat_fmt(s, "%.*f", precision, v)`.
+ * Values of moderate magnitude with at most 9 decimals are converted without
+ * printf; everything else (and the rare exact rounding ties) falls back to it.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param v The value to append.
+ * @param precision The number of decimals. Negative values are treated as 0.
+ * @return The updated `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_concat_double(ikstr s, double v, int precision);
+
 #ifdef __GNUC__
 /**
  * Appends a formatted string to the given `ikstr` instance.
@@ -523,6 +768,7 @@ IKSTR_API ikstr ikstr_concat_vfmt(ikstr s, const char* fmt, va_list ap);
  * @param fmt The format string, following the same rules as standard `printf`.
  *            This must be null-terminated and valid.
  * @param ... Additional arguments that match the format specifiers in `fmt`.
+ *            See `ikstr_concat_vfmt` for arguments that point into `s`.
  * @return The updated `ikstr` instance with the appended formatted string, or
  *         NULL if memory allocation fails or an error occurs.
  */
@@ -557,6 +803,7 @@ IKSTR_API ikstr ikstr_new_fmt(const char* fmt, ...) __attribute__((format(printf
  * @param fmt The format string, following the same rules as standard `printf`.
  *            This must be null-terminated and valid.
  * @param ... Additional arguments that match the format specifiers in `fmt`.
+ *            See `ikstr_concat_vfmt` for arguments that point into `s`.
  * @return The updated `ikstr` instance with the appended formatted string, or
  *         NULL if memory allocation fails or an error occurs.
  */
@@ -586,6 +833,7 @@ IKSTR_API ikstr ikstr_new_fmt(const char* fmt, ...);
  * This function removes all characters present in the `char_set` from
  * the beginning and end of the provided `ikstr` string. The operation
  * adjusts the string in place, modifying its contents and metadata.
+ * The content is only moved when characters are removed from the beginning.
  *
  * @param s The ikstr instance to be trimmed. This pointer must be valid
  *          and point to a dynamically allocated `ikstr`.
@@ -597,6 +845,103 @@ IKSTR_API ikstr ikstr_new_fmt(const char* fmt, ...);
  */
 IKSTR_API ikstr ikstr_trim(ikstr s, const char* char_set);
 
+/**
+ * A precompiled set of bytes, one bit per possible byte value.
+ *
+ * Membership is a single table lookup, so trimming with a set is linear in
+ * the number of bytes removed regardless of how many characters the set
+ * holds. Build it once with `ikstr_charset_init` and reuse it across calls.
+ */
+typedef struct ikstr_charset {
+    uint64_t bits[4];
+} ikstr_charset;
+
+/**
+ * Initializes a set with the characters of a null-terminated string.
+ *
+ * @param cs The set to initialize. Must not be NULL.
+ * @param chars The characters to put in the set. The terminating '\0' is
+ *              not part of the set.
+ */
+IKSTR_API void ikstr_charset_init(ikstr_charset *cs, const char *chars);
+
+/**
+ * Initializes a set with `len` arbitrary bytes, which may include '\0'.
+ *
+ * @param cs The set to initialize. Must not be NULL.
+ * @param chars The bytes to put in the set.
+ * @param len The number of bytes at `chars`.
+ */
+IKSTR_API void ikstr_charset_init_len(ikstr_charset *cs, const void *chars, size_t len);
+
+/**
+ * Adds a byte to a set.
+ *
+ * @param cs The set. Must not be NULL.
+ * @param c The byte to add.
+ */
+static inline void ikstr_charset_add(ikstr_charset *cs, unsigned char c) {
+    cs->bits[c >> 6] |= (uint64_t)1 << (c & 63);
+}
+
+/**
+ * Tests whether a byte is in a set.
+ *
+ * @param cs The set. Must not be NULL.
+ * @param c The byte to test.
+ * @return Nonzero if `c` is in the set, 0 otherwise.
+ */
+static inline int ikstr_charset_has(const ikstr_charset *cs, unsigned char c) {
+    return (int)((cs->bits[c >> 6] >> (c & 63)) & 1);
+}
+
+/**
+ * Same as `ikstr_trim`, with a precompiled set.
+ *
+ * @param s The ikstr instance to be trimmed. Must be a valid `ikstr`.
+ * @param cs The bytes to remove from both ends. Must not be NULL.
+ * @return The trimmed ikstr instance.
+ */
+IKSTR_API ikstr ikstr_trim_set(ikstr s, const ikstr_charset *cs);
+
+/**
+ * Removes all characters of `char_set` from the beginning of the string.
+ *
+ * @param s The ikstr instance to be trimmed. Must be a valid `ikstr`.
+ * @param char_set A null-terminated string with the characters to remove.
+ * @return The trimmed ikstr instance.
+ */
+IKSTR_API ikstr ikstr_ltrim(ikstr s, const char* char_set);
+
+/**
+ * Same as `ikstr_ltrim`, with a precompiled set.
+ *
+ * @param s The ikstr instance to be trimmed. Must be a valid `ikstr`.
+ * @param cs The bytes to remove. Must not be NULL.
+ * @return The trimmed ikstr instance.
+ */
+IKSTR_API ikstr ikstr_ltrim_set(ikstr s, const ikstr_charset *cs);
+
+/**
+ * Removes all characters of `char_set` from the end of the string.
+ *
+ * Only the length changes; the content is never moved.
+ *
+ * @param s The ikstr instance to be trimmed. Must be a valid `ikstr`.
+ * @param char_set A null-terminated string with the characters to remove.
+ * @return The trimmed ikstr instance.
+ */
+IKSTR_API ikstr ikstr_rtrim(ikstr s, const char* char_set);
+
+/**
+ * Same as `ikstr_rtrim`, with a precompiled set.
+ *
+ * @param s The ikstr instance to be trimmed. Must be a valid `ikstr`.
+ * @param cs The bytes to remove. Must not be NULL.
+ * @return The trimmed ikstr instance.
+ */
+IKSTR_API ikstr ikstr_rtrim_set(ikstr s, const ikstr_charset *cs);
+
 /**
  * Modifies the given ikstr instance to contain only the substring defined
  * by the specified start and end indexes.
@@ -614,8 +959,11 @@ IKSTR_API ikstr ikstr_trim(ikstr s, const char* char_set);
  *              an offset from the end of the string.
  * @param end The ending index of the range. Can be negative to indicate
  *            an offset from the end of the string.
+ * @return The modified `ikstr`. This is `s` itself unless `s` is shared, in
+ *         which case it is a private copy, or NULL if that copy cannot be
+ *         allocated.
  */
-IKSTR_API void ikstr_range(ikstr s, ssize_t start, ssize_t end);
+IKSTR_API ikstr ikstr_range(ikstr s, ssize_t start, ssize_t end);
 
 /**
  * Compares two ikstr instances lexicographically.
@@ -636,6 +984,80 @@ IKSTR_API void ikstr_range(ikstr s, ssize_t start, ssize_t end);
  */
 IKSTR_API int ikstr_cmp(ikstr s1, ikstr s2);
 
+/**
+ * Finds the first occurrence of a byte sequence in an `ikstr`.
+ *
+ * The search uses the length stored in the header, so embedded null bytes in
+ * either string are handled. Short needles are located with a SIMD filter on
+ * their first and last byte; long needles use the Two-Way algorithm, which is
+ * linear in the length of `s` even on adversarial input.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The bytes to search for. Must point to at least `len` bytes.
+ * @param len The length of `needle`. An empty needle matches at offset 0.
+ * @return The offset of the first match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_find_len(ikstr s, const void *needle, size_t len);
+
+/**
+ * Finds the first occurrence of a null-terminated C string in an `ikstr`.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The null-terminated C string to search for.
+ * @return The offset of the first match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_find(ikstr s, const char *needle);
+
+/**
+ * Finds the last occurrence of a byte sequence in an `ikstr`.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The bytes to search for. Must point to at least `len` bytes.
+ * @param len The length of `needle`. An empty needle matches at the end of `s`.
+ * @return The offset of the last match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_rfind_len(ikstr s, const void *needle, size_t len);
+
+/**
+ * Finds the last occurrence of a null-terminated C string in an `ikstr`.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The null-terminated C string to search for.
+ * @return The offset of the last match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_rfind(ikstr s, const char *needle);
+
+/**
+ * Finds the first occurrence of a byte in an `ikstr`.
+ *
+ * Unlike `strchr`, the whole length of `s` is searched, including any
+ * embedded null bytes, and the terminator is never matched.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param c The byte to search for (converted to `unsigned char`).
+ * @return The offset of the first match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_find_char(ikstr s, int c);
+
+/**
+ * Counts the non-overlapping occurrences of a byte sequence in an `ikstr`.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The bytes to search for. Must point to at least `len` bytes.
+ * @param len The length of `needle`. An empty needle is never counted.
+ * @return The number of non-overlapping matches, scanning from the start.
+ */
+IKSTR_API size_t ikstr_count_len(ikstr s, const void *needle, size_t len);
+
+/**
+ * Counts the non-overlapping occurrences of a C string in an `ikstr`.
+ *
+ * @param s The `ikstr` to search in. Must be a valid `ikstr`.
+ * @param needle The null-terminated C string to search for.
+ * @return The number of non-overlapping matches, scanning from the start.
+ */
+IKSTR_API size_t ikstr_count(ikstr s, const char *needle);
+
 /**
  * Splits a string into parts based on a specified separator.
  *
@@ -697,6 +1119,8 @@ IKSTR_API void ikstr_free_split_res(ikstr *tokens, int count);
  * This function iterates through the given array of strings (`argv`),
  * concatenates them into a new dynamically allocated `ikstr`, and inserts
  * the specified separator string (`sep`) between the concatenated strings.
+ * The total length is computed first, so the result is allocated exactly
+ * once, with the right header type and no spare capacity.
  *
  * @param argc The number of strings to concatenate. This must be greater than or equal to 0.
  * @param argv An array of C strings to be joined. The array must contain `argc` valid null-terminated
@@ -713,7 +1137,7 @@ IKSTR_API ikstr ikstr_join(int argc, char** argv, const char* sep);
  * This function combines an array of `ikstr` strings into a single `ikstr`,
  * inserting the provided separator between each string. If `argc` is 0,
  * the function will return an empty `ikstr`. If `sep` is `NULL`, no separator
- * will be used between the strings.
+ * will be used between the strings. Like `ikstr_join`, it allocates once.
  *
  * @param argc The number of `ikstr` strings in the `argv` array.
  *             Must be a non-negative integer.
@@ -727,6 +1151,55 @@ IKSTR_API ikstr ikstr_join(int argc, char** argv, const char* sep);
  */
 IKSTR_API ikstr ikstr_join_ikstr(int argc, ikstr *argv, const char* sep);
 
+/**
+ * Same as `ikstr_join`, with a `size_t` count.
+ *
+ * @param count The number of strings in `argv`.
+ * @param argv An array of `count` valid null-terminated strings.
+ * @param sep The separator to insert between strings. If NULL, none is used.
+ * @return A newly allocated `ikstr`, or NULL if memory allocation fails.
+ */
+IKSTR_API ikstr ikstr_join_n(size_t count, char** argv, const char* sep);
+
+/**
+ * Same as `ikstr_join_ikstr`, with a `size_t` count.
+ *
+ * @param count The number of strings in `argv`.
+ * @param argv An array of `count` valid `ikstr`.
+ * @param sep The separator to insert between strings. If NULL, none is used.
+ * @return A newly allocated `ikstr`, or NULL if memory allocation fails.
+ */
+IKSTR_API ikstr ikstr_join_ikstr_n(size_t count, ikstr *argv, const char* sep);
+
+/**
+ * Joins C strings with a separator and appends the result to `s`.
+ *
+ * `s` is grown at most once, by the exact joined length. Nothing is inserted
+ * between the existing content of `s` and the first joined string.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param count The number of strings in `argv`.
+ * @param argv An array of `count` valid null-terminated strings. Elements
+ *             may be `s` itself, but must not point elsewhere into `s`.
+ * @param sep The separator to insert between strings. If NULL, none is used.
+ *            Must not point into `s`.
+ * @return The updated `ikstr`, or NULL if memory allocation fails.
+ */
+IKSTR_API ikstr ikstr_join_into(ikstr s, size_t count, char** argv, const char* sep);
+
+/**
+ * Joins `ikstr` strings with a separator and appends the result to `s`.
+ *
+ * @param s The `ikstr` to append to. Must be a valid `ikstr`.
+ * @param count The number of strings in `argv`.
+ * @param argv An array of `count` valid `ikstr`. Elements may be `s`
+ *             itself, e.g. to repeat it.
+ * @param sep The separator to insert between strings. If NULL, none is used.
+ *            Must not point into `s`.
+ * @return The updated `ikstr`, or NULL if memory allocation fails.
+ */
+IKSTR_API ikstr ikstr_join_ikstr_into(ikstr s, size_t count, ikstr *argv, const char* sep);
+
 
 /**
  * Ensures that the given `ikstr` instance has enough available space to accommodate
@@ -746,4 +1219,81 @@ IKSTR_API ikstr ikstr_join_ikstr(int argc, ikstr *argv, const char* sep);
  */
 IKSTR_API ikstr ikstr_make_room_for(ikstr s, size_t addlen);
 
+/**
+ * How `ikstr_make_room_for` sizes a string that has to grow.
+ *
+ * - IKSTR_GROWTH_DEFAULT:   Double the required length while it is below
+ *                           `IKSTR_PREALLOC`, then add `IKSTR_PREALLOC`.
+ * - IKSTR_GROWTH_GEOMETRIC: Multiply the current capacity by `factor` (at
+ *                           least the required length). Keeps the number of
+ *                           reallocations logarithmic for very large buffers.
+ * - IKSTR_GROWTH_EXACT:     Allocate exactly the required length.
+ */
+typedef enum ikstr_growth_mode {
+    IKSTR_GROWTH_DEFAULT = 0,
+    IKSTR_GROWTH_GEOMETRIC,
+    IKSTR_GROWTH_EXACT,
+} ikstr_growth_mode;
+
+/**
+ * Growth policy, see `ikstr_set_growth`.
+ *
+ * - mode:        The growth mode.
+ * - factor:      Growth factor for IKSTR_GROWTH_GEOMETRIC. Values not greater
+ *                than 1 select 2.
+ * - usable_size: If nonzero, the capacity of a grown string is raised to the
+ *                real size of the block returned by the allocator (see the
+ *                `usable_size` callback of `ikstr_allocator`), so the slack of
+ *                the allocator's size class is not wasted.
+ */
+typedef struct ikstr_growth {
+    ikstr_growth_mode mode;
+    double factor;
+    int usable_size;
+} ikstr_growth;
+
+/**
+ * Sets the process-wide growth policy used by `ikstr_make_room_for`,
+ * `ikstr_reserve` (usable size only) and every function that appends.
+ *
+ * The policy is copied. It should be set before strings are grown from
+ * several threads.
+ *
+ * @param g The policy to use, or NULL to restore the default.
+ */
+IKSTR_API void ikstr_set_growth(const ikstr_growth *g);
+
+/**
+ * Returns the growth policy currently in effect.
+ *
+ * @return A copy of the policy.
+ */
+IKSTR_API ikstr_growth ikstr_get_growth(void);
+
+/**
+ * Ensures that the capacity of `s` is at least `cap` bytes.
+ *
+ * Unlike `ikstr_make_room_for`, the growth policy is not applied: the string
+ * is reallocated to exactly `cap` bytes (or the allocator's usable size, if
+ * enabled), so a known final size can be allocated up front.
+ *
+ * @param s The `ikstr` to reserve space in. Must be a valid `ikstr`.
+ * @param cap The total capacity wanted, not counting the trailing '\0'.
+ * @return The updated `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_reserve(ikstr s, size_t cap);
+
+/**
+ * Releases the free space at the end of a string.
+ *
+ * The capacity becomes the length, and the header shrinks to the smallest
+ * type that can hold it. Strings whose memory is not owned by the heap
+ * (arena and `ikstr_small` strings) are returned unchanged.
+ *
+ * @param s The `ikstr` to shrink. Must be a valid `ikstr`.
+ * @return The updated `ikstr`, or NULL if the allocation fails, in which case
+ *         `s` is left untouched.
+ */
+IKSTR_API ikstr ikstr_shrink_to_fit(ikstr s);
+
 #endif //IKSTR_IKSTR_H
\ No newline at end of file
@@ -4,9 +4,159 @@
 
 #ifndef IKSTR_IKSTR_ALLOC_H
 #define IKSTR_IKSTR_ALLOC_H
+#include "ikstr.h"
 
-#define iks_malloc malloc
-#define iks_realloc realloc
-#define iks_free free
+/**
+ * Runtime allocator interface used for every allocation made by ikstr.
+ *
+ * All callbacks receive the opaque `ctx` pointer of the allocator as their
+ * first argument, so stateful allocators (pools, tracking wrappers, ...) can
+ * be plugged in without globals.
+ *
+ * - alloc:         Required. Returns `size` bytes or NULL (like malloc).
+ * - resize:        Optional. Resizes `ptr` from `old_size` to `new_size` bytes
+ *                  (like realloc). If NULL, ikstr falls back to
+ *                  alloc + memcpy + release.
+ * - release:       Required. Releases `ptr` (like free).
+ * - release_sized: Optional. Releases `ptr`, which is known to be `size` bytes
+ *                  large. Used instead of `release` whenever the size is known.
+ * - ctx:           Passed through to every callback.
+ * - usable_size:   Optional. Returns how many bytes of the block `ptr`, which
+ *                  was requested with `size` bytes, can really be used. Only
+ *                  called when the growth policy enables `usable_size`; the
+ *                  returned size may later be passed to `resize` and
+ *                  `release_sized` for that block.
+ */
+typedef struct ikstr_allocator {
+    void *(*alloc)(void *ctx, size_t size);
+    void *(*resize)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*release)(void *ctx, void *ptr);
+    void (*release_sized)(void *ctx, void *ptr, size_t size);
+    void *ctx;
+    size_t (*usable_size)(void *ctx, void *ptr, size_t size);
+} ikstr_allocator;
 
-#endif //IKSTR_IKSTR_ALLOC_H
\ No newline at end of file
+/**
+ * Sets the process-wide allocator.
+ *
+ * The structure is not copied and must stay valid for as long as it is in
+ * use. Strings must be freed with the allocator they were created with, so
+ * the global allocator should be set before any string is created.
+ *
+ * @param a The allocator to use, or NULL to restore the libc allocator.
+ */
+IKSTR_API void ikstr_set_allocator(const ikstr_allocator *a);
+
+/**
+ * Sets the allocator of the calling thread, overriding the global one.
+ *
+ * The structure is not copied and must stay valid for as long as it is in
+ * use. Strings allocated under a thread allocator must be freed while the
+ * same allocator is active (or by a thread using the same allocator).
+ *
+ * @param a The allocator to use, or NULL to fall back to the global allocator.
+ */
+IKSTR_API void ikstr_set_thread_allocator(const ikstr_allocator *a);
+
+/**
+ * Returns the allocator currently in effect for the calling thread.
+ *
+ * @return The thread allocator if one is set, the global allocator otherwise.
+ */
+IKSTR_API const ikstr_allocator *ikstr_get_allocator(void);
+
+/*
+ * Allocation hooks used throughout the library. They dispatch to the
+ * allocator returned by ikstr_get_allocator and can also be used by callers
+ * that need memory from the same allocator as their strings.
+ */
+IKSTR_API void *iks_malloc(size_t size);
+IKSTR_API void *iks_realloc(void *ptr, size_t old_size, size_t new_size);
+IKSTR_API void iks_free(void *ptr);
+IKSTR_API void iks_free_sized(void *ptr, size_t size);
+IKSTR_API size_t iks_usable_size(void *ptr, size_t size);
+
+/**
+ * Largest block served by the thread cache (see `ikstr_tcache_init`): an
+ * `IKSTR_8` string with the full 255-byte capacity, including the prefix of
+ * a shared string, rounded up to the 16-byte size classes.
+ */
+#define IKSTR_TCACHE_MAX_SIZE 288
+
+/**
+ * Default number of blocks a thread keeps per size class.
+ */
+#define IKSTR_TCACHE_BLOCKS 128
+
+/**
+ * Configuration of the thread cache.
+ *
+ * - backing:    The allocator blocks are taken from and returned to, or NULL
+ *               for the libc allocator.
+ * - max_size:   Requests of up to this many bytes go through the cache. 0 or
+ *               anything larger means `IKSTR_TCACHE_MAX_SIZE`.
+ * - max_blocks: Number of free blocks a thread keeps per size class before
+ *               returning them to `backing`, or 0 for `IKSTR_TCACHE_BLOCKS`.
+ */
+typedef struct ikstr_tcache_config {
+    const ikstr_allocator *backing;
+    size_t max_size;
+    size_t max_blocks;
+} ikstr_tcache_config;
+
+/**
+ * Counters of the thread cache, summed over all threads.
+ *
+ * - hits:      Allocations served from a cache.
+ * - misses:    Allocations small enough for the cache that found it empty
+ *              and went to the backing allocator.
+ * - frees:     Frees that kept the block in a cache.
+ * - overflows: Frees of small blocks passed to the backing allocator because
+ *              the cache of their size class was full.
+ * - cached:    Blocks currently held by the caches.
+ */
+typedef struct ikstr_tcache_stats {
+    size_t hits;
+    size_t misses;
+    size_t frees;
+    size_t overflows;
+    size_t cached;
+} ikstr_tcache_stats;
+
+/**
+ * Configures the thread cache and returns its allocator.
+ *
+ * The thread cache keeps blocks of up to `IKSTR_TCACHE_MAX_SIZE` bytes (the
+ * size of short `IKSTR_8` strings) on per-thread free lists, one per 16-byte
+ * size class, so churning short-lived strings does not go through the
+ * backing allocator and its locks. Every cached block is a whole block of the
+ * backing allocator, so a block may be freed on any thread: it simply joins
+ * the cache of that thread. A thread's cached blocks are returned to the
+ * backing allocator when it exits (or calls `ikstr_tcache_flush`).
+ *
+ * The cache is off until the returned allocator is installed with
+ * `ikstr_set_allocator` or `ikstr_set_thread_allocator`. The configuration
+ * must not change while the allocator is in use.
+ *
+ * @param cfg The configuration, or NULL for the defaults. It is copied.
+ * @return The caching allocator, or NULL if the thread exit hook cannot be
+ *         set up.
+ */
+IKSTR_API const ikstr_allocator *ikstr_tcache_init(const ikstr_tcache_config *cfg);
+
+/**
+ * Returns the blocks cached by the calling thread to the backing allocator.
+ */
+IKSTR_API void ikstr_tcache_flush(void);
+
+/**
+ * Reads the counters of the thread cache.
+ *
+ * Counters of threads that have exited are included. The hit rate is
+ * `hits / (hits + misses)`.
+ *
+ * @param st Receives the counters. Must not be NULL.
+ */
+IKSTR_API void ikstr_tcache_get_stats(ikstr_tcache_stats *st);
+
+#endif //IKSTR_IKSTR_ALLOC_H
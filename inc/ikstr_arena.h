@@ -0,0 +1,154 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_ARENA_H
+#define IKSTR_IKSTR_ARENA_H
+#include "ikstr.h"
+
+/**
+ * Default size in bytes of a single arena block.
+ */
+#define IKSTR_ARENA_BLOCK (64 * 1024)
+
+/**
+ * Opaque region allocator for `ikstr` instances.
+ *
+ * Strings created from an arena live inside large blocks that are obtained
+ * with `iks_malloc` and handed out by bumping a pointer. They carry the
+ * `IKSTR_FLAG_BORROWED` flag: `ikstr_free` on them is a no-op and they are all
+ * released at once by `ikstr_arena_reset` or `ikstr_arena_destroy`.
+ *
+ * Arena strings can be passed to every read-only function of the library.
+ * Growing them through the regular API (e.g. `ikstr_concat`) moves them to the
+ * heap; use the `ikstr_arena_*` variants to keep them inside the arena.
+ */
+typedef struct ikstr_arena ikstr_arena;
+
+/**
+ * Creates a new, empty arena.
+ *
+ * No block is allocated until the first string is created.
+ *
+ * @param block_size The size in bytes of the blocks the arena carves strings
+ *                   from. Pass 0 to use `IKSTR_ARENA_BLOCK`. Strings that do not
+ *                   fit into a block get a dedicated block of their own.
+ * @return A pointer to the new arena, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr_arena *ikstr_arena_create(size_t block_size);
+
+/**
+ * Releases every string allocated from the arena in one go.
+ *
+ * Regular sized blocks are kept and reused by subsequent allocations, while
+ * oversized blocks are returned to the allocator. All `ikstr` instances that
+ * were obtained from the arena become invalid.
+ *
+ * @param a The arena to reset. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_arena_reset(ikstr_arena *a);
+
+/**
+ * Destroys an arena and all strings allocated from it.
+ *
+ * @param a The arena to destroy. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_arena_destroy(ikstr_arena *a);
+
+/**
+ * Returns the number of bytes currently handed out by the arena, including
+ * the string headers and the space lost to relocated strings.
+ *
+ * @param a The arena to inspect. Must be a valid arena.
+ * @return The number of bytes in use since the last reset.
+ */
+IKSTR_API size_t ikstr_arena_used(const ikstr_arena *a);
+
+/**
+ * Creates a new arena-backed `ikstr` with initial content and a specified length.
+ *
+ * Behaves like `ikstr_new_len`, including the handling of NULL and
+ * `IKSTR_NO_INIT` for `init`, but takes the memory from the arena.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param init Pointer to the initial content, NULL for zero-initialized
+ *             content, or `IKSTR_NO_INIT` for uninitialized content.
+ * @param init_len The length of the initial content.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_new_len(ikstr_arena *a, const void *init, size_t init_len);
+
+/**
+ * Creates a new arena-backed `ikstr` from a null-terminated C string.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param init The C string to copy. If NULL, an empty string is created.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_new(ikstr_arena *a, const char *init);
+
+/**
+ * Creates an empty arena-backed `ikstr`.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_empty(ikstr_arena *a);
+
+/**
+ * Copies any `ikstr` into a new arena-backed `ikstr`.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param s The string to copy. Must be a valid `ikstr`.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_dup(ikstr_arena *a, ikstr s);
+
+/**
+ * Arena counterpart of `ikstr_make_room_for`.
+ *
+ * If `s` is the most recent allocation of the arena and the current block has
+ * enough space left, the string is extended in place. Otherwise a larger
+ * string is bump-allocated and the content is copied; the old space is
+ * reclaimed on the next reset. A heap `ikstr` that has to grow is copied into
+ * the arena and freed.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param s The string to grow. Must be a valid `ikstr`.
+ * @param addlen The number of additional bytes required.
+ * @return The (possibly moved) string, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_make_room_for(ikstr_arena *a, ikstr s, size_t addlen);
+
+/**
+ * Arena counterpart of `ikstr_concat_len`.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param s The string to append to. Must be a valid `ikstr`.
+ * @param t The bytes to append. Must point to at least `len` bytes.
+ * @param len The number of bytes to append.
+ * @return The (possibly moved) string, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_concat_len(ikstr_arena *a, ikstr s, const void *t, size_t len);
+
+/**
+ * Arena counterpart of `ikstr_concat`.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param s The string to append to. Must be a valid `ikstr`.
+ * @param t The null-terminated C string to append.
+ * @return The (possibly moved) string, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_concat(ikstr_arena *a, ikstr s, const char *t);
+
+/**
+ * Arena counterpart of `ikstr_concat_ikstr`.
+ *
+ * @param a The arena to allocate from. Must be a valid arena.
+ * @param s The string to append to. Must be a valid `ikstr`.
+ * @param t The `ikstr` to append.
+ * @return The (possibly moved) string, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_arena_concat_ikstr(ikstr_arena *a, ikstr s, ikstr t);
+
+#endif //IKSTR_IKSTR_ARENA_H
@@ -0,0 +1,190 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_BUILDER_H
+#define IKSTR_IKSTR_BUILDER_H
+#include <stdarg.h>
+#include <string.h>
+#include "ikstr.h"
+#if !defined(_WIN32)
+#   include <sys/uio.h>
+#endif
+
+/**
+ * Default size of the first chunk of a builder.
+ */
+#define IKSTR_BUILDER_CHUNK 4096
+
+/**
+ * Chunks double in size as the content grows, up to this size.
+ */
+#define IKSTR_BUILDER_MAX_CHUNK (1024 * 1024)
+
+/**
+ * String builder.
+ *
+ * Appended bytes go into a list of chunks; when the last chunk is full a new
+ * one, twice as large, is linked in, so earlier data is never copied or moved
+ * while building, however large the result grows. The result is either
+ * copied once into an `ikstr` of the right size and header type
+ * (`ikstr_builder_finish`), or handed out chunk by chunk for vectored output
+ * (`ikstr_builder_to_iovec`).
+ *
+ * Appends that fit in the current chunk are inline and cost a bounds check
+ * and a `memcpy`.
+ *
+ * The fields are private and must not be accessed directly.
+ */
+typedef struct ikstr_builder {
+    char *pos;      // next free byte of the last chunk
+    char *end;      // end of the last chunk
+    size_t len;
+    struct ikstr_builder_chunk *head;
+    struct ikstr_builder_chunk *tail;
+    size_t chunks;
+    size_t chunk_size;
+} ikstr_builder;
+
+/**
+ * Initializes an empty builder. Nothing is allocated until the first append.
+ *
+ * @param b The builder to initialize. Must not be NULL.
+ * @param chunk_size The size of the first chunk in bytes, or 0 for the
+ *                   default (`IKSTR_BUILDER_CHUNK`). Appends larger than the
+ *                   next chunk get a chunk of their own size.
+ */
+IKSTR_API void ikstr_builder_init(ikstr_builder *b, size_t chunk_size);
+
+/**
+ * Empties a builder, keeping its first chunk for reuse.
+ *
+ * @param b The builder. Must not be NULL.
+ */
+IKSTR_API void ikstr_builder_reset(ikstr_builder *b);
+
+/**
+ * Frees every chunk of a builder. The builder can be initialized again.
+ *
+ * @param b The builder. Must not be NULL.
+ */
+IKSTR_API void ikstr_builder_free(ikstr_builder *b);
+
+/**
+ * Returns the number of bytes appended so far.
+ *
+ * @param b The builder. Must not be NULL.
+ * @return The length of the content.
+ */
+static inline size_t ikstr_builder_len(const ikstr_builder *b) {
+    return b->len;
+}
+
+/**
+ * Slow path of `ikstr_builder_append_len`, used when the bytes do not fit in
+ * the last chunk. Not meant to be called directly.
+ */
+IKSTR_API int ikstr_builder_append_slow(ikstr_builder *b, const void *p, size_t len);
+
+/**
+ * Appends `len` bytes.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param p The bytes to append. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return 0 on success, or -1 if an allocation fails, in which case the
+ *         builder is unchanged.
+ */
+static inline int ikstr_builder_append_len(ikstr_builder *b, const void *p, size_t len) {
+    if (len > (size_t)(b->end - b->pos)) return ikstr_builder_append_slow(b, p, len);
+    if (len) {
+        memcpy(b->pos, p, len);
+        b->pos += len;
+        b->len += len;
+    }
+    return 0;
+}
+
+/**
+ * Appends a null-terminated C string.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param t The string to append. Must not be NULL.
+ * @return 0 on success, or -1 if an allocation fails.
+ */
+IKSTR_API int ikstr_builder_append(ikstr_builder *b, const char *t);
+
+/**
+ * Appends the content of an `ikstr`.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param t The string to append. Must be a valid `ikstr`.
+ * @return 0 on success, or -1 if an allocation fails.
+ */
+IKSTR_API int ikstr_builder_append_ikstr(ikstr_builder *b, ikstr t);
+
+/**
+ * Appends the decimal representation of a signed integer, without going
+ * through printf.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param v The value.
+ * @return 0 on success, or -1 if an allocation fails.
+ */
+IKSTR_API int ikstr_builder_append_int(ikstr_builder *b, long long v);
+
+/**
+ * Same as `ikstr_builder_append_fmt`, with a `va_list`.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param fmt The printf-style format string.
+ * @param ap The arguments.
+ * @return 0 on success, or -1 if an allocation or the formatting fails.
+ */
+IKSTR_API int ikstr_builder_append_vfmt(ikstr_builder *b, const char *fmt, va_list ap);
+
+/**
+ * Appends printf-style formatted text.
+ *
+ * The text is formatted straight into the free space of the last chunk, or
+ * into a new chunk if it does not fit.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param fmt The printf-style format string.
+ * @param ... The arguments matching `fmt`.
+ * @return 0 on success, or -1 if an allocation or the formatting fails.
+ */
+#ifdef __GNUC__
+IKSTR_API int ikstr_builder_append_fmt(ikstr_builder *b, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+#else
+IKSTR_API int ikstr_builder_append_fmt(ikstr_builder *b, const char *fmt, ...);
+#endif
+
+/**
+ * Copies the content into a new `ikstr` with exactly one allocation, sized
+ * for the content with the narrowest header that fits, and resets the
+ * builder.
+ *
+ * @param b The builder. Must not be NULL.
+ * @return The new `ikstr`, or NULL if the allocation fails, in which case
+ *         the builder is unchanged.
+ */
+IKSTR_API ikstr ikstr_builder_finish(ikstr_builder *b);
+
+#if !defined(_WIN32)
+/**
+ * Describes the content as a list of buffers for `writev`, without copying.
+ *
+ * At most `max` entries are stored; the return value is the total number of
+ * chunks, so a result larger than `max` tells the caller how large `iov`
+ * would need to be. The buffers are valid until the builder is modified.
+ *
+ * @param b The builder. Must not be NULL.
+ * @param iov The array receiving the buffers. May be NULL if `max` is 0.
+ * @param max The capacity of `iov`.
+ * @return The number of non-empty chunks.
+ */
+IKSTR_API size_t ikstr_builder_to_iovec(const ikstr_builder *b, struct iovec *iov, size_t max);
+#endif
+
+#endif //IKSTR_IKSTR_BUILDER_H
@@ -0,0 +1,159 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_FILE_H
+#define IKSTR_IKSTR_FILE_H
+#include "ikstr.h"
+#include "ikstr_view.h"
+
+/**
+ * Maps a file into memory and returns it as a read-only `ikstr`.
+ *
+ * The file is mapped with `mmap` right behind a page holding the header, so
+ * the result is an ordinary `ikstr` to every function that reads strings
+ * (`ikstr_len`, `ikstr_cmp`, split, search, views, ...) and the content is
+ * never copied: pages are read from the page cache as they are touched. The
+ * content is null-terminated like any other `ikstr`.
+ *
+ * The string is read-only. Every modifying function first replaces it with a
+ * private heap copy (see `IKSTR_FLAG_MAPPED`), so edits work as usual and
+ * the file is never written; writing through the pointer directly crashes.
+ * `ikstr_free` unmaps the file. If the file is truncated while it is mapped,
+ * reading past the new end raises SIGBUS.
+ *
+ * On platforms without `mmap` the file is read into a heap string instead.
+ *
+ * @param path The path of a regular file. Must not be NULL.
+ * @return The content of the file, or NULL if it cannot be opened, is not a
+ *         regular file, or cannot be mapped (`errno` tells why). An empty
+ *         file gives an ordinary empty string.
+ */
+IKSTR_API ikstr ikstr_map_file(const char *path);
+
+/**
+ * Reads a whole file into a new heap `ikstr`.
+ *
+ * The size of a regular file is used to allocate the string once, with
+ * room to detect the end of the file without growing it; files of unknown
+ * size (pipes, `/proc`) are read in chunks.
+ *
+ * @param path The path of the file. Must not be NULL.
+ * @return The content of the file, or NULL if it cannot be opened or read,
+ *         or an allocation fails (`errno` tells why).
+ */
+IKSTR_API ikstr ikstr_read_file(const char *path);
+
+#if !defined(_WIN32)
+/**
+ * Size of the free tail `ikstr_read_fd` makes sure of when no limit is given.
+ */
+#define IKSTR_IO_CHUNK 16384
+
+/**
+ * Reads from a file descriptor straight into the free tail of a string.
+ *
+ * Makes room for `max` bytes first (following the growth policy, see
+ * `ikstr_set_growth`), then does a single `read` into the tail and appends
+ * what it returned, so no intermediate buffer is involved. Interrupted reads
+ * are retried.
+ *
+ * @param s The string to append to. Must not be NULL and must point to a
+ *          valid `ikstr`; it is updated if the string moves.
+ * @param fd The file descriptor to read from.
+ * @param max The maximum number of bytes to read, or 0 to read as much as
+ *            fits in the free tail, growing it to at least `IKSTR_IO_CHUNK`
+ *            bytes first.
+ * @return The number of bytes appended, 0 at the end of the input, or -1 on
+ *         error (`errno` tells why, ENOMEM if making room failed). `*s` is
+ *         always valid.
+ */
+IKSTR_API ssize_t ikstr_read_fd(ikstr *s, int fd, size_t max);
+
+/**
+ * Writes a whole string to a file descriptor.
+ *
+ * Short writes are continued and interrupted writes retried until every
+ * byte is written or an error occurs.
+ *
+ * @param fd The file descriptor to write to.
+ * @param s The string to write. Must be a valid `ikstr`.
+ * @return `ikstr_len(s)` on success. On error, the number of bytes written
+ *         before it, or -1 if there were none; `errno` tells why (e.g.
+ *         EAGAIN on a non-blocking descriptor, or EIO if `write` wrote
+ *         nothing without failing).
+ */
+IKSTR_API ssize_t ikstr_write_fd(int fd, ikstr s);
+
+/**
+ * Writes several strings to a file descriptor with vectored I/O.
+ *
+ * The strings are handed to `writev` as they are, without being joined,
+ * so up to 256 of them go out in a single system call. Short writes are
+ * continued from where they stopped, as in `ikstr_write_fd`.
+ *
+ * @param fd The file descriptor to write to.
+ * @param strs The strings to write, in order. May be NULL if `count` is 0.
+ * @param count The number of strings.
+ * @return The total number of bytes written on success. On error, the number
+ *         of bytes written before it, or -1 if there were none.
+ */
+IKSTR_API ssize_t ikstr_writev_many(int fd, const ikstr *strs, size_t count);
+
+/**
+ * Size of the reads a line reader refills its buffer with.
+ */
+#define IKSTR_LINE_READ 262144
+
+/**
+ * Reader of newline-delimited records from a file descriptor.
+ *
+ * The reader owns one growing `ikstr` buffer, refilled with reads of
+ * `IKSTR_LINE_READ` bytes straight into its tail (see `ikstr_read_fd`).
+ * Lines are returned as views into the buffer, so reading a line never
+ * allocates. Consumed bytes are only dropped when a refill needs the space:
+ * the unfinished last line is then moved to the front of the buffer, and the
+ * buffer only grows for lines longer than it.
+ *
+ * The fields are private and must not be accessed directly.
+ */
+typedef struct ikstr_line_reader {
+    ikstr buf;
+    size_t pos;
+    size_t scanned;
+    int fd;
+    int eof;
+} ikstr_line_reader;
+
+/**
+ * Initializes a line reader. The buffer is allocated on the first read.
+ *
+ * @param lr The reader to initialize. Must not be NULL.
+ * @param fd The file descriptor to read from. It is not closed by the reader.
+ */
+IKSTR_API void ikstr_line_reader_init(ikstr_line_reader *lr, int fd);
+
+/**
+ * Reads the next line.
+ *
+ * The line is returned without its terminating `'\n'`; a `'\r'` before it is
+ * kept. The last line is returned even if it has no terminator. The view
+ * points into the buffer of the reader and is valid until the next call on
+ * the reader.
+ *
+ * @param lr The reader. Must not be NULL.
+ * @param line Receives the line. Must not be NULL.
+ * @return 1 if a line was produced, 0 at the end of the input, or -1 if a
+ *         read or an allocation failed (`errno` tells why).
+ */
+IKSTR_API int ikstr_line_reader_next(ikstr_line_reader *lr, ikstr_view *line);
+
+/**
+ * Releases the buffer of a line reader.
+ *
+ * @param lr The reader. Must not be NULL.
+ */
+IKSTR_API void ikstr_line_reader_free(ikstr_line_reader *lr);
+#endif
+
+#endif //IKSTR_IKSTR_FILE_H
@@ -0,0 +1,104 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_INTERN_H
+#define IKSTR_IKSTR_INTERN_H
+#include "ikstr.h"
+
+/**
+ * String interning pool.
+ *
+ * The pool keeps one canonical `ikstr` per distinct content. Interning the
+ * same bytes twice returns the same pointer, so interned strings can be
+ * compared for equality with `==` instead of `ikstr_cmp`, and repeated values
+ * are stored once.
+ *
+ * The canonical strings are owned by the pool and are released together by
+ * `ikstr_intern_pool_reset` or `ikstr_intern_pool_destroy`. They must not be
+ * modified or freed directly. They are shared strings (see `ikstr_share`): to
+ * keep one alive beyond the pool, take a reference with `ikstr_retain` and
+ * free it with `ikstr_free` later.
+ *
+ * Internally the pool is an open-addressing hash table with linear probing
+ * that stores the hash of every entry, so growing the table never rehashes
+ * the strings and most mismatches are rejected without touching them.
+ */
+typedef struct ikstr_intern_pool ikstr_intern_pool;
+
+/**
+ * Flags for `ikstr_intern_pool_create`.
+ *
+ * - IKSTR_INTERN_CONCURRENT: the pool may be used from several threads at
+ *   once. Lookups of existing strings take a shared (read) lock, only the
+ *   insertion of a new string takes the exclusive lock.
+ */
+enum {
+    IKSTR_INTERN_CONCURRENT = 1 << 0,
+};
+
+/**
+ * Creates a new, empty pool.
+ *
+ * @param flags 0 or `IKSTR_INTERN_CONCURRENT`.
+ * @return The new pool, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr_intern_pool *ikstr_intern_pool_create(int flags);
+
+/**
+ * Releases every canonical string of the pool in one go. The table keeps its
+ * size and can be reused.
+ *
+ * Must not run concurrently with other calls on the same pool.
+ *
+ * @param p The pool. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_intern_pool_reset(ikstr_intern_pool *p);
+
+/**
+ * Releases every canonical string and the pool itself.
+ *
+ * @param p The pool. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_intern_pool_destroy(ikstr_intern_pool *p);
+
+/**
+ * Returns the number of distinct strings in the pool.
+ *
+ * @param p The pool. Must not be NULL.
+ * @return The number of canonical strings.
+ */
+IKSTR_API size_t ikstr_intern_pool_count(ikstr_intern_pool *p);
+
+/**
+ * Returns the canonical string for `len` bytes, adding it to the pool if it
+ * is not there yet.
+ *
+ * @param p The pool. Must not be NULL.
+ * @param s The bytes to intern. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return The canonical `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_intern_len(ikstr_intern_pool *p, const void *s, size_t len);
+
+/**
+ * Same as `ikstr_intern_len` for a null-terminated C string (or an `ikstr`
+ * without embedded '\0').
+ *
+ * @param p The pool. Must not be NULL.
+ * @param s The string to intern. Must not be NULL.
+ * @return The canonical `ikstr`, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr ikstr_intern(ikstr_intern_pool *p, const char *s);
+
+/**
+ * Looks up the canonical string for `len` bytes without adding it.
+ *
+ * @param p The pool. Must not be NULL.
+ * @param s The bytes to look up. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return The canonical `ikstr`, or NULL if the pool does not hold it.
+ */
+IKSTR_API ikstr ikstr_intern_find_len(ikstr_intern_pool *p, const void *s, size_t len);
+
+#endif //IKSTR_IKSTR_INTERN_H
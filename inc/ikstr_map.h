@@ -0,0 +1,131 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_MAP_H
+#define IKSTR_IKSTR_MAP_H
+#include "ikstr.h"
+
+/**
+ * Hash map from strings to `void*` values.
+ *
+ * The map is an open-addressing table in the style of Swiss tables: next to
+ * the slots it keeps one control byte per slot holding 7 bits of the key's
+ * hash (or an empty/deleted marker). A lookup loads 16 control bytes at once
+ * and compares them against the hash in one SIMD instruction (SSE2, with a
+ * portable fallback), so only slots whose 7 bits match are looked at. Each
+ * slot stores the full 64-bit hash, and its key is only compared after the
+ * hash and the length from the key's header both match.
+ *
+ * Keys are stored as `ikstr`s owned by the map. Inserting a shared string
+ * (see `ikstr_share`) only takes a reference; any other key is copied. Keys
+ * can be looked up by `ikstr` or by pointer and length, without building one.
+ *
+ * A map is not thread-safe. Pointers returned by lookups stay valid until the
+ * next insertion or removal.
+ */
+typedef struct ikstr_map ikstr_map;
+
+/**
+ * Creates a new, empty map.
+ *
+ * @param capacity The number of entries to make room for up front, or 0.
+ * @return The new map, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr_map *ikstr_map_create(size_t capacity);
+
+/**
+ * Removes every entry and frees the keys. The table keeps its size and can be
+ * reused.
+ *
+ * @param m The map. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_map_clear(ikstr_map *m);
+
+/**
+ * Frees the keys and the map itself. The values are not touched.
+ *
+ * @param m The map. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_map_destroy(ikstr_map *m);
+
+/**
+ * Returns the number of entries.
+ *
+ * @param m The map. Must not be NULL.
+ * @return The number of entries.
+ */
+IKSTR_API size_t ikstr_map_count(const ikstr_map *m);
+
+/**
+ * Inserts or replaces the value stored for `len` bytes at `key`.
+ *
+ * @param m The map. Must not be NULL.
+ * @param key The key bytes. May be NULL if `len` is 0.
+ * @param len The length of the key.
+ * @param value The value to store.
+ * @return 0 on success, or -1 if an allocation fails, in which case the map
+ *         is unchanged.
+ */
+IKSTR_API int ikstr_map_put_len(ikstr_map *m, const void *key, size_t len, void *value);
+
+/**
+ * Inserts or replaces the value stored for an `ikstr` key.
+ *
+ * Uses the hash cached in `key`, if any (see `ikstr_cache_hash`). A shared
+ * key is stored by reference, any other key is copied.
+ *
+ * @param m The map. Must not be NULL.
+ * @param key The key. Must be a valid `ikstr`.
+ * @param value The value to store.
+ * @return 0 on success, or -1 if an allocation fails, in which case the map
+ *         is unchanged.
+ */
+IKSTR_API int ikstr_map_put(ikstr_map *m, ikstr key, void *value);
+
+/**
+ * Looks up `len` bytes at `key`.
+ *
+ * @param m The map. Must not be NULL.
+ * @param key The key bytes. May be NULL if `len` is 0.
+ * @param len The length of the key.
+ * @return A pointer to the stored value, which may be read and written, or
+ *         NULL if the key is not in the map.
+ */
+IKSTR_API void **ikstr_map_find_len(const ikstr_map *m, const void *key, size_t len);
+
+/**
+ * Looks up an `ikstr` key, using its cached hash if it has one.
+ *
+ * @param m The map. Must not be NULL.
+ * @param key The key. Must be a valid `ikstr`.
+ * @return A pointer to the stored value, or NULL if the key is not in the map.
+ */
+IKSTR_API void **ikstr_map_find(const ikstr_map *m, ikstr key);
+
+/**
+ * Removes the entry for `len` bytes at `key` and frees its key.
+ *
+ * @param m The map. Must not be NULL.
+ * @param key The key bytes. May be NULL if `len` is 0.
+ * @param len The length of the key.
+ * @param value Receives the removed value. May be NULL.
+ * @return 1 if an entry was removed, 0 if the key was not in the map.
+ */
+IKSTR_API int ikstr_map_remove_len(ikstr_map *m, const void *key, size_t len, void **value);
+
+/**
+ * Iterates over the entries in table order.
+ *
+ * Start with `*pos` set to 0. The map must not be modified during iteration,
+ * except for writing values through the returned pointers.
+ *
+ * @param m The map. Must not be NULL.
+ * @param pos The iteration cursor. Must not be NULL.
+ * @param key Receives the key, owned by the map. May be NULL.
+ * @param value Receives the value. May be NULL.
+ * @return 1 if an entry was produced, 0 after the last one.
+ */
+IKSTR_API int ikstr_map_next(const ikstr_map *m, size_t *pos, ikstr *key, void **value);
+
+#endif //IKSTR_IKSTR_MAP_H
@@ -0,0 +1,121 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_MATCHER_H
+#define IKSTR_IKSTR_MATCHER_H
+#include "ikstr.h"
+
+/**
+ * Compiled multi-pattern matcher (Aho-Corasick).
+ *
+ * The automaton is stored as one flat transition table indexed by
+ * `state * classes + class`, where bytes that do not occur in any pattern
+ * share a single class. Entries store the pre-multiplied row of the target
+ * state and a bit telling whether that state reports matches. Failure links
+ * are resolved at compile time, so scanning takes exactly one table lookup
+ * per input byte regardless of the number of patterns.
+ */
+typedef struct ikstr_matcher ikstr_matcher;
+
+/**
+ * Callback invoked for every match found by `ikstr_matcher_scan`.
+ *
+ * @param ctx The user pointer passed to the scan function.
+ * @param pattern_id The index of the matching needle in the array given to
+ *                   `ikstr_matcher_compile`.
+ * @param offset The offset of the first byte of the match in the input.
+ * @return 0 to continue scanning, any other value to stop.
+ */
+typedef int (*ikstr_match_cb)(void *ctx, size_t pattern_id, size_t offset);
+
+/**
+ * Builds a matcher from an array of needles.
+ *
+ * The needles are copied into the automaton and can be freed afterwards.
+ * Empty needles never match.
+ *
+ * @param needles The patterns to search for. Each must be a valid `ikstr`.
+ * @param count The number of needles.
+ * @return The compiled matcher, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr_matcher *ikstr_matcher_compile(const ikstr *needles, size_t count);
+
+/**
+ * Frees a matcher.
+ *
+ * @param m The matcher to free. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_matcher_free(ikstr_matcher *m);
+
+/**
+ * Returns the number of automaton states, mostly useful for sizing estimates.
+ *
+ * @param m The matcher. Must not be NULL.
+ * @return The number of states.
+ */
+IKSTR_API size_t ikstr_matcher_states(const ikstr_matcher *m);
+
+/**
+ * Scans bytes in a single pass and reports every occurrence of every pattern.
+ *
+ * Matches are reported in order of their end offset; matches ending at the
+ * same offset are reported longest first.
+ *
+ * @param m The matcher. Must not be NULL.
+ * @param s The bytes to scan.
+ * @param len The number of bytes to scan.
+ * @param cb The callback receiving the matches. Must not be NULL.
+ * @param ctx A user pointer passed to `cb`.
+ * @return The number of matches reported.
+ */
+IKSTR_API size_t ikstr_matcher_scan_len(const ikstr_matcher *m, const char *s, size_t len,
+                                        ikstr_match_cb cb, void *ctx);
+
+/**
+ * Scans an `ikstr` in a single pass and reports every occurrence of every pattern.
+ *
+ * @param m The matcher. Must not be NULL.
+ * @param s The `ikstr` to scan. Must be a valid `ikstr`.
+ * @param cb The callback receiving the matches. Must not be NULL.
+ * @param ctx A user pointer passed to `cb`.
+ * @return The number of matches reported.
+ */
+IKSTR_API size_t ikstr_matcher_scan(const ikstr_matcher *m, ikstr s, ikstr_match_cb cb, void *ctx);
+
+/**
+ * Pull-style alternative to the scan callback.
+ *
+ * The fields are private and must not be accessed directly.
+ */
+typedef struct ikstr_match_iter {
+    const ikstr_matcher *m;
+    const char *s;
+    size_t len;
+    size_t pos;
+    size_t state; // row offset of the current state
+    size_t out;
+    size_t out_end;
+} ikstr_match_iter;
+
+/**
+ * Initializes a match iterator over `len` bytes at `s`.
+ *
+ * @param it The iterator to initialize. Must not be NULL.
+ * @param m The matcher. Must stay valid while the iterator is used.
+ * @param s The bytes to scan. Must stay valid while the iterator is used.
+ * @param len The number of bytes to scan.
+ */
+IKSTR_API void ikstr_match_iter_init(ikstr_match_iter *it, const ikstr_matcher *m, const char *s, size_t len);
+
+/**
+ * Advances to the next match, in the same order as `ikstr_matcher_scan_len`.
+ *
+ * @param it The iterator. Must not be NULL.
+ * @param pattern_id Receives the index of the matching needle.
+ * @param offset Receives the offset of the first byte of the match.
+ * @return 1 if a match was produced, 0 at the end of the input.
+ */
+IKSTR_API int ikstr_match_iter_next(ikstr_match_iter *it, size_t *pattern_id, size_t *offset);
+
+#endif //IKSTR_IKSTR_MATCHER_H
@@ -0,0 +1,181 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_ROPE_H
+#define IKSTR_IKSTR_ROPE_H
+#include "ikstr.h"
+
+/**
+ * Rope: a long string stored as a balanced tree of chunks.
+ *
+ * Every node of the tree references a range of a shared `ikstr` chunk, and
+ * the tree is kept balanced as a treap ordered by position. Inserting,
+ * erasing and taking a substring only split and join the tree along one or
+ * two paths, so they take O(log n) time in the number of chunks and never
+ * move the rest of the text, unlike `ikstr_concat`/`ikstr_range` on a flat
+ * multi-megabyte string.
+ *
+ * Chunks are never copied when a rope is edited: splitting one only creates
+ * two nodes referencing parts of it. Subtrees are shared between ropes
+ * created by `ikstr_rope_substr` and copied on write, the same way
+ * `ikstr_share` works for strings. Small insertions next to a chunk that is
+ * not shared are appended to it in place, so typing-style edits do not
+ * create a node per byte.
+ *
+ * A rope is not thread-safe, but ropes sharing subtrees can be used from
+ * different threads.
+ */
+typedef struct ikstr_rope ikstr_rope;
+
+/**
+ * Creates an empty rope.
+ *
+ * @return The new rope, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr_rope *ikstr_rope_new(void);
+
+/**
+ * Creates a rope holding a copy of `len` bytes.
+ *
+ * @param init The initial content. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return The new rope, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr_rope *ikstr_rope_new_len(const void *init, size_t len);
+
+/**
+ * Frees a rope. Chunks still referenced elsewhere stay alive.
+ *
+ * @param r The rope to free. If NULL, the function does nothing.
+ */
+IKSTR_API void ikstr_rope_free(ikstr_rope *r);
+
+/**
+ * Returns the length of the rope in bytes.
+ *
+ * @param r The rope. Must not be NULL.
+ * @return The length.
+ */
+IKSTR_API size_t ikstr_rope_len(const ikstr_rope *r);
+
+/**
+ * Inserts a copy of `len` bytes at offset `pos`.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param pos The offset to insert at, at most `ikstr_rope_len(r)`.
+ * @param p The bytes to insert. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return 0 on success, or -1 if `pos` is out of range or an allocation
+ *         fails, in which case the rope is unchanged.
+ */
+IKSTR_API int ikstr_rope_insert_len(ikstr_rope *r, size_t pos, const void *p, size_t len);
+
+/**
+ * Inserts an `ikstr` at offset `pos`.
+ *
+ * A shared string (see `ikstr_share`) becomes a chunk of the rope by
+ * reference, without copying; any other string is copied.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param pos The offset to insert at, at most `ikstr_rope_len(r)`.
+ * @param s The string to insert. Must be a valid `ikstr`.
+ * @return 0 on success, or -1 if `pos` is out of range or an allocation
+ *         fails, in which case the rope is unchanged.
+ */
+IKSTR_API int ikstr_rope_insert(ikstr_rope *r, size_t pos, ikstr s);
+
+/**
+ * Appends a copy of `len` bytes.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param p The bytes to append. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return 0 on success, or -1 if an allocation fails.
+ */
+IKSTR_API int ikstr_rope_append_len(ikstr_rope *r, const void *p, size_t len);
+
+/**
+ * Removes `len` bytes starting at offset `pos`.
+ *
+ * The range is clamped to the end of the rope.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param pos The offset of the first byte to remove.
+ * @param len The number of bytes to remove.
+ * @return 0 on success, or -1 if an allocation fails, in which case the rope
+ *         is unchanged.
+ */
+IKSTR_API int ikstr_rope_erase(ikstr_rope *r, size_t pos, size_t len);
+
+/**
+ * Creates a new rope holding `len` bytes of `r` starting at `pos`.
+ *
+ * The new rope shares the chunks and most of the tree with `r`; no text is
+ * copied. The range is clamped to the end of `r`.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param pos The offset of the first byte.
+ * @param len The number of bytes.
+ * @return The new rope, or NULL if an allocation fails.
+ */
+IKSTR_API ikstr_rope *ikstr_rope_substr(const ikstr_rope *r, size_t pos, size_t len);
+
+/**
+ * Returns the byte at offset `pos`.
+ *
+ * @param r The rope. Must not be NULL.
+ * @param pos The offset, less than `ikstr_rope_len(r)`.
+ * @return The byte.
+ */
+IKSTR_API char ikstr_rope_at(const ikstr_rope *r, size_t pos);
+
+/**
+ * Copies the content of a rope into a new `ikstr` with one allocation.
+ *
+ * @param r The rope. Must not be NULL.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_rope_flatten(const ikstr_rope *r);
+
+/**
+ * Returns the number of chunks, i.e. the number of steps of a
+ * `ikstr_rope_iter` over the whole rope.
+ *
+ * @param r The rope. Must not be NULL.
+ * @return The number of chunks.
+ */
+IKSTR_API size_t ikstr_rope_chunks(const ikstr_rope *r);
+
+/**
+ * Iterator over the chunks of a rope, in order.
+ *
+ * Chunks are returned as pointers into the rope, ready to be passed to
+ * `writev` or copied elsewhere without flattening the rope first.
+ *
+ * The fields are private and must not be accessed directly.
+ */
+typedef struct ikstr_rope_iter {
+    const ikstr_rope *r;
+    size_t pos;
+} ikstr_rope_iter;
+
+/**
+ * Initializes an iterator at the start of a rope.
+ *
+ * @param it The iterator to initialize. Must not be NULL.
+ * @param r The rope. Must not be modified while the iterator is used.
+ */
+IKSTR_API void ikstr_rope_iter_init(ikstr_rope_iter *it, const ikstr_rope *r);
+
+/**
+ * Advances to the next chunk.
+ *
+ * @param it The iterator. Must not be NULL.
+ * @param ptr Receives the start of the chunk. Not null-terminated.
+ * @param len Receives the length of the chunk, never 0.
+ * @return 1 if a chunk was produced, 0 at the end of the rope.
+ */
+IKSTR_API int ikstr_rope_iter_next(ikstr_rope_iter *it, const char **ptr, size_t *len);
+
+#endif //IKSTR_IKSTR_ROPE_H
@@ -0,0 +1,88 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_STATS_H
+#define IKSTR_IKSTR_STATS_H
+#include "ikstr.h"
+
+/**
+ * Functions whose calls are counted. Variants are counted under the function
+ * they are built on, e.g. `ikstr_new` and `ikstr_dup` as `IKSTR_CALL_NEW` and
+ * `ikstr_concat` as `IKSTR_CALL_CONCAT`.
+ *
+ * - IKSTR_CALL_NEW:       `ikstr_new_len` and the constructors built on it.
+ * - IKSTR_CALL_FREE:      `ikstr_free`.
+ * - IKSTR_CALL_CONCAT:    `ikstr_concat_len` and its variants.
+ * - IKSTR_CALL_COPY:      `ikstr_copy_len` and `ikstr_copy`.
+ * - IKSTR_CALL_FMT:       `ikstr_concat_vfmt` and the formatting functions.
+ * - IKSTR_CALL_MAKE_ROOM: `ikstr_make_room_for`, including the calls made by
+ *                         appending functions.
+ * - IKSTR_CALL_RANGE:     `ikstr_range`.
+ * - IKSTR_CALL_TRIM:      The trimming functions.
+ * - IKSTR_CALL_FIND:      The search and count functions.
+ * - IKSTR_CALL_SPLIT:     `ikstr_split_len` and `ikstr_split_len_batch`.
+ * - IKSTR_CALL_JOIN:      The join functions.
+ * - IKSTR_CALL_SHARE:     `ikstr_share`.
+ */
+typedef enum ikstr_stats_call {
+    IKSTR_CALL_NEW,
+    IKSTR_CALL_FREE,
+    IKSTR_CALL_CONCAT,
+    IKSTR_CALL_COPY,
+    IKSTR_CALL_FMT,
+    IKSTR_CALL_MAKE_ROOM,
+    IKSTR_CALL_RANGE,
+    IKSTR_CALL_TRIM,
+    IKSTR_CALL_FIND,
+    IKSTR_CALL_SPLIT,
+    IKSTR_CALL_JOIN,
+    IKSTR_CALL_SHARE,
+    IKSTR_CALL_COUNT
+} ikstr_stats_call;
+
+/**
+ * Counters of the library, summed over all threads.
+ *
+ * - allocs:       Calls to `iks_malloc`.
+ * - reallocs:     Calls to `iks_realloc`.
+ * - frees:        Calls to `iks_free` and `iks_free_sized`.
+ * - alloc_bytes:  Bytes requested by `iks_malloc` and `iks_realloc`.
+ * - migrations:   Strings moved to a block with another header type when
+ *                 their capacity changed (e.g. growing past 255 bytes).
+ * - bytes_copied: String content copied by the library: construction,
+ *                 appending, copying, joining, and moving strings between
+ *                 blocks.
+ * - slack_bytes:  Spare capacity handed out by `ikstr_make_room_for` beyond
+ *                 the length that was asked for, i.e. the `ikstr_avail` the
+ *                 growth policy added.
+ * - calls:        Calls per function, indexed by `ikstr_stats_call`.
+ */
+typedef struct ikstr_stats {
+    size_t allocs;
+    size_t reallocs;
+    size_t frees;
+    size_t alloc_bytes;
+    size_t migrations;
+    size_t bytes_copied;
+    size_t slack_bytes;
+    size_t calls[IKSTR_CALL_COUNT];
+} ikstr_stats;
+
+/**
+ * Reads the counters of the library.
+ *
+ * Counters are only kept if the library is built with `IKSTR_STATS` defined
+ * (the `IKSTR_STATS` CMake option); otherwise the hooks compile to nothing.
+ * Each thread updates its own counters without locking; a snapshot sums the
+ * counters of all threads, including those that have exited. Counters only
+ * grow, so the activity of a section of code is the difference between two
+ * snapshots.
+ *
+ * @param st Receives the counters, all 0 if statistics are not compiled in.
+ *           Must not be NULL.
+ * @return 0 on success, or -1 if the library was built without statistics.
+ */
+IKSTR_API int ikstr_stats_snapshot(ikstr_stats *st);
+
+#endif //IKSTR_IKSTR_STATS_H
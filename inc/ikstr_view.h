@@ -0,0 +1,258 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_VIEW_H
+#define IKSTR_IKSTR_VIEW_H
+#include <string.h>
+#include "ikstr.h"
+
+/**
+ * A non-owning reference to a sequence of bytes.
+ *
+ * A view is a plain pointer + length pair. It never allocates, is never
+ * freed, and is not null-terminated in general. It stays valid for as long
+ * as the memory it points into does (e.g. until the `ikstr` it was taken from
+ * is modified or freed).
+ */
+typedef struct ikstr_view {
+    const char *ptr;
+    size_t len;
+} ikstr_view;
+
+/**
+ * Returns a view covering the whole content of an `ikstr`.
+ *
+ * @param s The `ikstr` to view. Must be a valid `ikstr`.
+ * @return A view of `s`.
+ */
+static inline ikstr_view ikstr_view_of(ikstr s) {
+    ikstr_view v = {s, ikstr_len(s)};
+    return v;
+}
+
+/**
+ * Returns a view over `len` bytes starting at `ptr`.
+ *
+ * @param ptr The start of the bytes. May be NULL if `len` is 0.
+ * @param len The number of bytes.
+ * @return The view.
+ */
+static inline ikstr_view ikstr_view_from(const char *ptr, size_t len) {
+    ikstr_view v = {ptr, len};
+    return v;
+}
+
+/**
+ * Returns a view of a null-terminated C string (without the terminator).
+ *
+ * @param cstr The C string. Must not be NULL.
+ * @return The view.
+ */
+static inline ikstr_view ikstr_view_cstr(const char *cstr) {
+    ikstr_view v = {cstr, strlen(cstr)};
+    return v;
+}
+
+/**
+ * Creates a new heap `ikstr` holding a copy of the viewed bytes.
+ *
+ * @param v The view to copy.
+ * @return The new `ikstr`, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr ikstr_new_view(ikstr_view v);
+
+/**
+ * Compares two views lexicographically, with the same semantics as `ikstr_cmp`.
+ *
+ * @param a The first view.
+ * @param b The second view.
+ * @return A negative value, 0, or a positive value if `a` is respectively
+ *         less than, equal to, or greater than `b`.
+ */
+IKSTR_API int ikstr_view_cmp(ikstr_view a, ikstr_view b);
+
+/**
+ * Narrows a view by removing all characters of `char_set` from both ends.
+ *
+ * The underlying bytes are not modified.
+ *
+ * @param v The view to trim.
+ * @param char_set A null-terminated string with the characters to remove.
+ * @return The trimmed view, pointing into the same memory as `v`.
+ */
+IKSTR_API ikstr_view ikstr_view_trim(ikstr_view v, const char *char_set);
+
+/**
+ * Same as `ikstr_view_trim`, with a precompiled set.
+ *
+ * @param v The view to trim.
+ * @param cs The bytes to remove from both ends. Must not be NULL.
+ * @return The trimmed view, pointing into the same memory as `v`.
+ */
+IKSTR_API ikstr_view ikstr_view_trim_set(ikstr_view v, const ikstr_charset *cs);
+
+/**
+ * Finds the first occurrence of `needle` in `hay`.
+ *
+ * @param hay The view to search in.
+ * @param needle The bytes to search for. An empty needle matches at offset 0.
+ * @return The offset of the first match, or -1 if there is none.
+ */
+IKSTR_API ssize_t ikstr_view_find(ikstr_view hay, ikstr_view needle);
+
+/**
+ * Splits a string into views without allocating.
+ *
+ * Works like `ikstr_split_len`, but instead of allocating one `ikstr` per token
+ * it stores views into `s` in the caller-supplied array `out`. At most `max`
+ * views are stored; the return value is the total number of tokens, so a
+ * result larger than `max` tells the caller how large `out` would need to be.
+ *
+ * @param s The input string. Must not be NULL if `len` is greater than 0.
+ * @param len The length of `s`. If 0, no tokens are produced.
+ * @param sep The separator. Must not be NULL.
+ * @param sep_len The length of `sep`. If 0, no tokens are produced.
+ * @param out The array receiving the token views. May be NULL if `max` is 0.
+ * @param max The capacity of `out`.
+ * @return The number of tokens in `s`.
+ */
+IKSTR_API size_t ikstr_split_view(const char *s, size_t len, const char *sep, size_t sep_len,
+                                  ikstr_view *out, size_t max);
+
+/**
+ * Creates `count` strings in a single allocation.
+ *
+ * The returned array and all the strings, headers included, are laid out
+ * contiguously in one block: creating them costs one allocation instead of
+ * `count`, and walking them touches consecutive memory. The strings carry
+ * `IKSTR_FLAG_BORROWED`, like arena strings: they can be modified in place,
+ * growing one moves it to a heap copy, and `ikstr_free` on them is a no-op.
+ * The whole batch is released with `ikstr_free_batch`.
+ *
+ * @param items The contents of the strings. May be NULL if `count` is 0.
+ * @param count The number of strings.
+ * @return The array of `count` strings, or NULL if the allocation fails.
+ */
+IKSTR_API ikstr *ikstr_new_batch(const ikstr_view *items, size_t count);
+
+/**
+ * Frees an array created by `ikstr_new_batch` or `ikstr_split_len_batch`,
+ * together with its strings.
+ *
+ * Entries that were replaced by heap copies (after growing a string) are
+ * freed as well.
+ *
+ * @param strs The array. If NULL, the function does nothing.
+ * @param count The number of entries in `strs`.
+ */
+IKSTR_API void ikstr_free_batch(ikstr *strs, size_t count);
+
+/**
+ * Same as `ikstr_split_len`, but the tokens are created with
+ * `ikstr_new_batch`: the array and every token share one allocation.
+ *
+ * The tokens are borrowed from the batch, so they must not outlive it. The
+ * result is freed with `ikstr_free_batch` (or `ikstr_free_split_res`).
+ *
+ * @param s The input string. Must not be NULL if `len` is greater than 0.
+ * @param len The length of `s`. If 0, no tokens are produced.
+ * @param sep The separator. Must not be NULL.
+ * @param sep_len The length of `sep`. If 0, no tokens are produced.
+ * @param count Receives the number of tokens, 0 on error. Must not be NULL.
+ * @return The array of tokens, or NULL if there are none or an allocation
+ *         fails.
+ */
+IKSTR_API ikstr *ikstr_split_len_batch(const char *s, ssize_t len, const char *sep, int sep_len, int *count);
+
+/**
+ * Lazy split iterator.
+ *
+ * Yields the tokens of `ikstr_split_len` one at a time as views, without
+ * allocating. The input can be given at once (`ikstr_split_iter_init`) or fed
+ * in successive chunks (`ikstr_split_iter_init_stream` + `ikstr_split_iter_feed`
+ * + `ikstr_split_iter_finish`). Tokens, including multi-byte separators, may
+ * span chunk boundaries; only such tokens are copied into an internal carry
+ * buffer, which is reused for the lifetime of the iterator.
+ *
+ * The fields are private and must not be accessed directly.
+ */
+typedef struct ikstr_split_iter {
+    const char *sep;
+    size_t sep_len;
+    const char *cur;
+    const char *end;
+    ikstr carry;
+    int finished;
+    int pending;
+    int clear_carry;
+} ikstr_split_iter;
+
+/**
+ * Initializes an iterator over a complete input.
+ *
+ * The input and the separator must stay valid while the iterator is used.
+ *
+ * @param it The iterator to initialize. Must not be NULL.
+ * @param s The input string. Must not be NULL if `len` is greater than 0.
+ * @param len The length of `s`. If 0, no tokens are produced.
+ * @param sep The separator. Must not be NULL.
+ * @param sep_len The length of `sep`. If 0, no tokens are produced.
+ */
+IKSTR_API void ikstr_split_iter_init(ikstr_split_iter *it, const char *s, size_t len,
+                                     const char *sep, size_t sep_len);
+
+/**
+ * Initializes an iterator that receives its input in chunks.
+ *
+ * @param it The iterator to initialize. Must not be NULL.
+ * @param sep The separator. Must not be NULL and must stay valid while the
+ *            iterator is used.
+ * @param sep_len The length of `sep`. If 0, no tokens are produced.
+ */
+IKSTR_API void ikstr_split_iter_init_stream(ikstr_split_iter *it, const char *sep, size_t sep_len);
+
+/**
+ * Feeds the next chunk of input to a streaming iterator.
+ *
+ * Must only be called once `ikstr_split_iter_next` has returned 0 for the
+ * previous chunk. The chunk must stay valid until then.
+ *
+ * @param it The iterator. Must not be NULL.
+ * @param chunk The next bytes of the input.
+ * @param len The length of `chunk`.
+ */
+IKSTR_API void ikstr_split_iter_feed(ikstr_split_iter *it, const char *chunk, size_t len);
+
+/**
+ * Marks the end of the input of a streaming iterator.
+ *
+ * After this call `ikstr_split_iter_next` yields the remaining tokens,
+ * including the last one.
+ *
+ * @param it The iterator. Must not be NULL.
+ */
+IKSTR_API void ikstr_split_iter_finish(ikstr_split_iter *it);
+
+/**
+ * Advances the iterator to the next token.
+ *
+ * The returned view points either into the input or into the carry buffer of
+ * the iterator and is valid until the next call on the iterator.
+ *
+ * @param it The iterator. Must not be NULL.
+ * @param tok Receives the token. Must not be NULL.
+ * @return 1 if a token was produced, 0 if more input is needed (or, after
+ *         `ikstr_split_iter_finish`, if all tokens have been produced), or -1
+ *         if growing the carry buffer failed.
+ */
+IKSTR_API int ikstr_split_iter_next(ikstr_split_iter *it, ikstr_view *tok);
+
+/**
+ * Releases the carry buffer of an iterator.
+ *
+ * @param it The iterator. Must not be NULL.
+ */
+IKSTR_API void ikstr_split_iter_free(ikstr_split_iter *it);
+
+#endif //IKSTR_IKSTR_VIEW_H
@@ -4,47 +4,24 @@
 
 #include "ikstr.h"
 #include "ikstr_alloc.h"
-#include <limits.h>
+#include "ikstr_internal.h"
+#include <math.h> // signbit
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 char* IKSTR_NO_INIT = "__IKSTR_NO_INIT__";
 
-static inline int ikstr_hdr_size(unsigned char type) {
-    switch (type & IKSTR_TYPE_MASK) {
-        case IKSTR_8:
-            return sizeof(struct ikstrhdr8);
-        case IKSTR_16:
-            return sizeof(struct ikstrhdr16);
-        case IKSTR_32:
-            return sizeof(struct ikstrhdr32);
-        case IKSTR_64:
-            return sizeof(struct ikstrhdr64);
-        default:
-            return 0 ;
-    }
-}
-
-static inline char ikstr_req_type(size_t len) {
-    if (len < 256) return IKSTR_8;
-    if (len < 65536) return IKSTR_16;
-#if(LONG_MAX == LLONG_MAX)
-    if (len < 4294967296) return IKSTR_32;
-    return IKSTR_64;
-#else
-    return IKSTR_32;
-#endif
-}
-
-ikstr ikstr_new_len(const void *init, size_t init_len) {
+/*
+ * Allocates a string of `init_len` bytes with a header of the given type,
+ * which must be able to hold `init_len`.
+ */
+static ikstr ikstr_new_typed(const void *init, size_t init_len, unsigned char type) {
     void *sh;
     ikstr s;
-
-    unsigned char type = ikstr_req_type(init_len);
     int hdr_len = ikstr_hdr_size(type);
-    unsigned char *flag_ptr; // Pointer to the flag;
 
+    IKSTR_STAT_CALL(IKSTR_CALL_NEW);
 	size_t byte_size = hdr_len + init_len + 1;
 	sh = iks_malloc(byte_size);
     if (NULL == sh) return NULL ;
@@ -52,42 +29,29 @@ ikstr ikstr_new_len(const void *init, size_t init_len) {
     else if (!init) memset(sh, 0, hdr_len + init_len + 1);
 
     s = (char*)sh + hdr_len;
-    flag_ptr = ((unsigned char*)s) - 1;
-    switch (type) {
-        case IKSTR_8: {
-            IKSTR_HDR_VAR(8, s);
-            shdr->len = init_len;
-            shdr->cap = init_len;
-            break;
-        }
-        case IKSTR_16: {
-            IKSTR_HDR_VAR(16, s);
-            shdr->len = init_len;
-            shdr->cap = init_len;
-            break;
-        }
-        case IKSTR_32: {
-            IKSTR_HDR_VAR(32, s);
-            shdr->len = init_len;
-            shdr->cap = init_len;
-            break;
-        }
-        case IKSTR_64: {
-            IKSTR_HDR_VAR(64, s);
-            shdr->len = init_len;
-            shdr->cap = init_len;
-            break;
-        }
-        default:
-            break;
+    ikstr_init_hdr(s, type, init_len, init_len);
+    if (init_len && init) {
+        memcpy(s, init, init_len);
+        IKSTR_STAT_ADD(bytes_copied, init_len);
     }
-    *flag_ptr = type;
-    if (init_len && init) memcpy(s, init, init_len);
     s[init_len] = '\0';
     // ReSharper disable once CppDFAMemoryLeak
     return s;
 }
 
+ikstr ikstr_new_len(const void *init, size_t init_len) {
+    return ikstr_new_typed(init, init_len, ikstr_req_type(init_len));
+}
+
+ikstr ikstr_new_growable_len(const void *init, size_t init_len) {
+    return ikstr_new_typed(init, init_len, ikstr_req_type(SIZE_MAX));
+}
+
+ikstr ikstr_new_growable(const char *init) {
+    size_t len = NULL == init ? 0 : strlen(init);
+    return ikstr_new_growable_len(init, len);
+}
+
 ikstr ikstr_empty(void) {
     return ikstr_new_len("", 0);
 }
@@ -97,13 +61,41 @@ ikstr ikstr_new(const char *init) {
     return ikstr_new_len(init, len);
 }
 
+ikstr ikstr_small_new_len(ikstr_small *sm, const void *init, size_t init_len) {
+    ikstr s;
+
+    if (init_len > IKSTR_SMALL_CAP) return ikstr_new_len(init, init_len);
+
+    s = sm->buf + sizeof(struct ikstrhdr8);
+    ikstr_init_hdr(s, IKSTR_8 | IKSTR_FLAG_BORROWED, init_len, IKSTR_SMALL_CAP);
+    if (init == IKSTR_NO_INIT) init = 0;
+    else if (!init) memset(s, 0, init_len);
+    if (init_len && init) memcpy(s, init, init_len);
+    s[init_len] = '\0';
+    return s;
+}
+
+ikstr ikstr_small_new(ikstr_small *sm, const char *init) {
+    size_t len = NULL == init ? 0 : strlen(init);
+    return ikstr_small_new_len(sm, init, len);
+}
+
 ikstr ikstr_dup(ikstr s) {
     return ikstr_new_len(s, ikstr_len(s));
 }
 
 void ikstr_free(ikstr s) {
-    if (NULL == s) return;
-    iks_free((char*)s - ikstr_hdr_size(s[-1]));
+    size_t prefix;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FREE);
+    if (NULL == s || (s[-1] & IKSTR_FLAG_BORROWED)) return;
+    if (s[-1] & IKSTR_FLAG_MAPPED) {
+        ikstr_unmap(s);
+        return;
+    }
+    if ((s[-1] & IKSTR_FLAG_SHARED) && ikstr_ref_dec(&ikstr_ext_of(s)->refs) != 0) return;
+    prefix = ikstr_prefix_size(s);
+    iks_free_sized((char*)s - prefix, prefix + ikstr_cap(s) + 1);
 }
 
 ikstr ikstr_grow(ikstr s, size_t len) {
@@ -119,9 +111,12 @@ ikstr ikstr_grow(ikstr s, size_t len) {
 
 ikstr ikstr_concat_len(ikstr s, const void *t, size_t len) {
     size_t l = ikstr_len(s);
+
+    IKSTR_STAT_CALL(IKSTR_CALL_CONCAT);
     s = ikstr_make_room_for(s, len);
     if (NULL == s) return NULL ;
     memcpy(s + l, t, len);
+    IKSTR_STAT_ADD(bytes_copied, len);
     ikstr_set_len(s, l + len);
     s[l + len] = '\0';
     return s;
@@ -136,11 +131,22 @@ ikstr ikstr_concat_ikstr(ikstr s, ikstr t) {
 }
 
 ikstr ikstr_copy_len(ikstr s, const char *t, size_t len) {
+    IKSTR_STAT_CALL(IKSTR_CALL_COPY);
+    // Content is replaced, so a shared string or a mapped file needs no copy
+    // of the old one
+    if ((s[-1] & IKSTR_FLAG_MAPPED) || ((s[-1] & IKSTR_FLAG_SHARED) && ikstr_refcount(s) > 1)) {
+        ikstr c = ikstr_new_len(t, len);
+        if (NULL == c) return NULL ;
+        ikstr_free(s);
+        return c;
+    }
+    s = ikstr_unshare(s, 0);
     if (ikstr_cap(s) < len) {
         s = ikstr_make_room_for(s, len - ikstr_len(s));
         if (NULL == s) return NULL ;
     }
     memcpy(s, t, len);
+    IKSTR_STAT_ADD(bytes_copied, len);
     s[len] = '\0';
     ikstr_set_len(s, len);
     return s;
@@ -150,45 +156,209 @@ ikstr ikstr_copy(ikstr s, const char *t) {
     return ikstr_copy_len(s, t, strlen(t));
 }
 
-ikstr ikstr_concat_vfmt(ikstr s, const char *fmt, va_list ap) {
-    va_list ap2;
+/*
+ * Whether `fmt` has a %s conversion, i.e. reads a string argument that may
+ * point into the string being appended to.
+ */
+static int ikstr_fmt_reads_str(const char *fmt) {
+    for (const char *p = strchr(fmt, '%'); p; p = strchr(p, '%')) {
+        ++p;
+        if ('%' == *p) {
+            ++p;
+            continue;
+        }
+        // Argument index, flags, width, precision and length modifiers
+        p += strspn(p, "0123456789$-+ #'*.hljztL");
+        if ('s' == *p || 'S' == *p) return 1;
+    }
+    return 0;
+}
+
+/*
+ * Formats into a separate buffer and appends the result, for arguments that
+ * may point into `s`.
+ */
+static ikstr ikstr_concat_vfmt_copy(ikstr s, const char *fmt, va_list ap) {
     char static_buf[1024], *buf = static_buf;
-    size_t buf_len = strlen(fmt);
-    int bufstrlen;
+    va_list ap2;
+    int n;
+
+    va_copy(ap2, ap);
+    n = vsnprintf(buf, sizeof(static_buf), fmt, ap2);
+    va_end(ap2);
+    if (n < 0) return NULL;
 
-    // Try to use static buffer for speed
-    if (buf_len > sizeof(static_buf)) {
-        buf = (char*)iks_malloc(buf_len);
+    if ((size_t)n >= sizeof(static_buf)) {
+        buf = iks_malloc((size_t)n + 1);
         if (NULL == buf) return NULL ;
-    } else {
-        buf_len = sizeof(static_buf);
+        va_copy(ap2, ap);
+        n = vsnprintf(buf, (size_t)n + 1, fmt, ap2);
+        va_end(ap2);
+        if (n < 0) {
+            iks_free(buf);
+            return NULL;
+        }
     }
+    s = ikstr_concat_len(s, buf, (size_t)n);
+    if (buf != static_buf) iks_free(buf);
+    return s;
+}
 
-    while (1) {
+ikstr ikstr_concat_vfmt(ikstr s, const char *fmt, va_list ap) {
+    va_list ap2;
+    size_t len = ikstr_len(s);
+    int n;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FMT);
+    // A string argument may be `s` itself, which must not be read while it
+    // is written to or after it is reallocated
+    if (ikstr_fmt_reads_str(fmt)) return ikstr_concat_vfmt_copy(s, fmt, ap);
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+
+    // Only numbers are formatted here, so format straight into the free
+    // tail; it has avail + 1 bytes including the room for the terminator
+    va_copy(ap2, ap);
+    n = vsnprintf(s + len, ikstr_avail(s) + 1, fmt, ap2);
+    va_end(ap2);
+    if (n < 0) {
+        s[len] = '\0';
+        return NULL;
+    }
+
+    if ((size_t)n > ikstr_avail(s)) {
+        s[len] = '\0';
+        s = ikstr_make_room_for(s, (size_t)n);
+        if (NULL == s) return NULL ;
         va_copy(ap2, ap);
-        bufstrlen = vsnprintf(buf, buf_len, fmt, ap2);
+        n = vsnprintf(s + len, (size_t)n + 1, fmt, ap2);
         va_end(ap2);
-
-        if (bufstrlen < 0) {
-            if (buf != static_buf)
-                iks_free(buf);
+        if (n < 0) {
+            s[len] = '\0';
             return NULL;
         }
-        if ((size_t)bufstrlen >= buf_len) {
-            if (buf != static_buf)
-                iks_free(buf);
-            buf_len = (size_t)bufstrlen + 1;
-            buf = iks_malloc(buf_len);
-            if (NULL == buf) return NULL ;
-            continue;
-        }
-        break;
     }
+    ikstr_set_len(s, len + (size_t)n);
+    return s;
+}
+
+static const char ikstr_digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+unsigned ikstr_u64_digits(uint64_t v) {
+    unsigned n = 1;
+
+    for (;;) {
+        if (v < 10) return n;
+        if (v < 100) return n + 1;
+        if (v < 1000) return n + 2;
+        if (v < 10000) return n + 3;
+        v /= 10000;
+        n += 4;
+    }
+}
+
+void ikstr_u64_write(char *end, uint64_t v) {
+    while (v >= 100) {
+        unsigned i = (unsigned)(v % 100) * 2;
+        v /= 100;
+        *--end = ikstr_digit_pairs[i + 1];
+        *--end = ikstr_digit_pairs[i];
+    }
+    if (v >= 10) {
+        *--end = ikstr_digit_pairs[v * 2 + 1];
+        *--end = ikstr_digit_pairs[v * 2];
+    } else {
+        *--end = (char)('0' + v);
+    }
+}
+
+/*
+ * Appends an optional '-' followed by the decimal digits of `v`.
+ */
+static ikstr ikstr_concat_u64(ikstr s, uint64_t v, int neg) {
+    size_t len = ikstr_len(s), n = ikstr_u64_digits(v) + (neg ? 1 : 0);
+
+    s = ikstr_make_room_for(s, n);
+    if (NULL == s) return NULL ;
+    if (neg) s[len] = '-';
+    ikstr_u64_write(s + len + n, v);
+    s[len + n] = '\0';
+    ikstr_set_len(s, len + n);
+    return s;
+}
+
+ikstr ikstr_concat_int(ikstr s, long long v) {
+    // Negate in unsigned arithmetic so LLONG_MIN does not overflow
+    if (v < 0) return ikstr_concat_u64(s, 0 - (uint64_t)v, 1);
+    return ikstr_concat_u64(s, (uint64_t)v, 0);
+}
 
-    char *t = ikstr_concat_len(s, buf, bufstrlen);
-    if (buf != static_buf)
-        iks_free(buf);
-    return t;
+ikstr ikstr_concat_uint(ikstr s, unsigned long long v) {
+    return ikstr_concat_u64(s, (uint64_t)v, 0);
+}
+
+ikstr ikstr_concat_hex(ikstr s, unsigned long long v) {
+    static const char xdigits[] = "0123456789abcdef";
+    size_t len = ikstr_len(s), n = 1;
+    char *p;
+
+    for (unsigned long long t = v >> 4; t; t >>= 4) ++n;
+    s = ikstr_make_room_for(s, n);
+    if (NULL == s) return NULL ;
+    p = s + len + n;
+    *p = '\0';
+    do {
+        *--p = xdigits[v & 15];
+        v >>= 4;
+    } while (v);
+    ikstr_set_len(s, len + n);
+    return s;
+}
+
+ikstr ikstr_concat_double(ikstr s, double v, int precision) {
+    static const double scale[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    double a, scaled, frac;
+    uint64_t units, ipart, fpart;
+    size_t len, n;
+    int neg;
+
+    if (precision < 0) precision = 0;
+    a = v < 0 ? -v : v;
+    scaled = a * scale[precision < 10 ? precision : 0];
+    // The fast path rounds v * 10^precision to an integer. It agrees with
+    // printf as long as the product is small enough to be accurate to well
+    // below half a unit and is not close to a rounding tie.
+    if (precision > 9 || !(scaled < 1099511627776.0)) // 2^40, also rejects NaN/inf
+        return ikstr_concat_fmt(s, "%.*f", precision, v);
+    units = (uint64_t)scaled;
+    frac = scaled - (double)units;
+    if (frac > 0.499 && frac < 0.501) return ikstr_concat_fmt(s, "%.*f", precision, v);
+    if (frac > 0.5) ++units;
+
+    ipart = units / (uint64_t)scale[precision];
+    fpart = units % (uint64_t)scale[precision];
+    neg = signbit(v) != 0;
+    n = (neg ? 1 : 0) + ikstr_u64_digits(ipart) + (precision ? (size_t)precision + 1 : 0);
+
+    len = ikstr_len(s);
+    s = ikstr_make_room_for(s, n);
+    if (NULL == s) return NULL ;
+    if (neg) s[len] = '-';
+    if (precision) {
+        char *dot = s + len + n - precision - 1;
+        memset(dot + 1, '0', (size_t)precision);
+        if (fpart) ikstr_u64_write(s + len + n, fpart);
+        *dot = '.';
+        ikstr_u64_write(dot, ipart);
+    } else {
+        ikstr_u64_write(s + len + n, ipart);
+    }
+    s[len + n] = '\0';
+    ikstr_set_len(s, len + n);
+    return s;
 }
 
 ikstr ikstr_concat_fmt(ikstr s, const char *fmt, ...) {
@@ -208,27 +378,97 @@ ikstr ikstr_new_fmt(const char *fmt, ...) {
     return s;
 }
 
+void ikstr_charset_init(ikstr_charset *cs, const char *chars) {
+    memset(cs, 0, sizeof(*cs));
+    while (*chars) ikstr_charset_add(cs, (unsigned char)*chars++);
+}
+
+void ikstr_charset_init_len(ikstr_charset *cs, const void *chars, size_t len) {
+    const unsigned char *c = chars;
+
+    memset(cs, 0, sizeof(*cs));
+    for (size_t i = 0; i < len; ++i) ikstr_charset_add(cs, c[i]);
+}
+
+ikstr ikstr_trim_set(ikstr s, const ikstr_charset *cs) {
+    size_t len = ikstr_len(s), start;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_TRIM);
+    start = ikstr_span(s, len, cs);
+    len -= start;
+    len -= ikstr_rspan(s + start, len, cs);
+    // Nothing to trim: leave a shared string shared
+    if (len == ikstr_len(s)) return s;
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+
+    if (start) {
+        memmove(s, s + start, len);
+        IKSTR_STAT_ADD(bytes_copied, len);
+    }
+    s[len] = '\0';
+    ikstr_set_len(s, len);
+    return s;
+}
+
 ikstr ikstr_trim(ikstr s, const char *char_set) {
-    char* str_end, *start_ptr, *end_ptr;
-    size_t len;
+    ikstr_charset cs;
+
+    ikstr_charset_init(&cs, char_set);
+    return ikstr_trim_set(s, &cs);
+}
+
+ikstr ikstr_ltrim_set(ikstr s, const ikstr_charset *cs) {
+    size_t len = ikstr_len(s), start;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_TRIM);
+    start = ikstr_span(s, len, cs);
+    if (start == 0) return s;
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+    len -= start;
+    memmove(s, s + start, len);
+    IKSTR_STAT_ADD(bytes_copied, len);
+    s[len] = '\0';
+    ikstr_set_len(s, len);
+    return s;
+}
 
-    start_ptr = s;
-    end_ptr = str_end = s + ikstr_len(s) - 1;
+ikstr ikstr_ltrim(ikstr s, const char *char_set) {
+    ikstr_charset cs;
 
-    while (start_ptr <= str_end && strchr(char_set, *start_ptr)) start_ptr++;
-    while (end_ptr > start_ptr && strchr(char_set, *end_ptr)) end_ptr--;
+    ikstr_charset_init(&cs, char_set);
+    return ikstr_ltrim_set(s, &cs);
+}
+
+ikstr ikstr_rtrim_set(ikstr s, const ikstr_charset *cs) {
+    size_t len = ikstr_len(s), end;
 
-    len = end_ptr - start_ptr + 1;
-    if (s != start_ptr) memmove(s, start_ptr, len);
+    IKSTR_STAT_CALL(IKSTR_CALL_TRIM);
+    end = ikstr_rspan(s, len, cs);
+    if (end == 0) return s;
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+    len -= end;
     s[len] = '\0';
     ikstr_set_len(s, len);
     return s;
 }
 
-void ikstr_range(ikstr s, ssize_t start, ssize_t end) {
+ikstr ikstr_rtrim(ikstr s, const char *char_set) {
+    ikstr_charset cs;
+
+    ikstr_charset_init(&cs, char_set);
+    return ikstr_rtrim_set(s, &cs);
+}
+
+ikstr ikstr_range(ikstr s, ssize_t start, ssize_t end) {
     size_t new_len, len = ikstr_len(s);
 
-    if (len == 0) return;
+    IKSTR_STAT_CALL(IKSTR_CALL_RANGE);
+    if (len == 0) return s;
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
     if (start < 0) {
         start = (ssize_t)len + start;
         if (start < 0) start = 0;
@@ -248,9 +488,13 @@ void ikstr_range(ikstr s, ssize_t start, ssize_t end) {
         }
     }
 
-    if (start && new_len) memmove(s, s + start, new_len);
+    if (start && new_len) {
+        memmove(s, s + start, new_len);
+        IKSTR_STAT_ADD(bytes_copied, new_len);
+    }
     s[new_len] = '\0';
     ikstr_set_len(s, new_len);
+    return s;
 }
 
 int ikstr_cmp(ikstr s1, ikstr s2) {
@@ -261,11 +505,63 @@ int ikstr_cmp(ikstr s1, ikstr s2) {
     return l1 < l2 ? -1 : l1 > l2 ? 1 : 0;
 }
 
+ssize_t ikstr_find_len(ikstr s, const void *needle, size_t len) {
+    const char *p;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FIND);
+    if (len == 0) return 0;
+    p = ikstr_memmem(s, ikstr_len(s), needle, len);
+    return p ? p - s : -1;
+}
+
+ssize_t ikstr_find(ikstr s, const char *needle) {
+    return ikstr_find_len(s, needle, strlen(needle));
+}
+
+ssize_t ikstr_rfind_len(ikstr s, const void *needle, size_t len) {
+    const char *p;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FIND);
+    if (len == 0) return (ssize_t)ikstr_len(s);
+    p = ikstr_memrmem(s, ikstr_len(s), needle, len);
+    return p ? p - s : -1;
+}
+
+ssize_t ikstr_rfind(ikstr s, const char *needle) {
+    return ikstr_rfind_len(s, needle, strlen(needle));
+}
+
+ssize_t ikstr_find_char(ikstr s, int c) {
+    const char *p;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FIND);
+    p = memchr(s, c, ikstr_len(s));
+    return p ? p - s : -1;
+}
+
+size_t ikstr_count_len(ikstr s, const void *needle, size_t len) {
+    const char *p = s, *end = s + ikstr_len(s);
+    size_t count = 0;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_FIND);
+    if (len == 0) return 0;
+    while ((p = ikstr_memmem(p, end - p, needle, len)) != NULL) {
+        ++count;
+        p += len;
+    }
+    return count;
+}
+
+size_t ikstr_count(ikstr s, const char *needle) {
+    return ikstr_count_len(s, needle, strlen(needle));
+}
+
 ikstr* ikstr_split_len(const char *s, ssize_t len, const char *sep, int sep_len, int *count) {
     int elements = 0, slots = 5;
-    long start = 0, j;
+    const char *start = s, *end = s + len, *hit;
     ikstr *result = NULL;
 
+    IKSTR_STAT_CALL(IKSTR_CALL_SPLIT);
     if (sep_len <= 0 || len <= 0) {
         *count = 0;
         return NULL;
@@ -274,28 +570,24 @@ ikstr* ikstr_split_len(const char *s, ssize_t len, const char *sep, int sep_len,
     result = (ikstr*)iks_malloc(sizeof(ikstr) * slots);
     if (NULL == result) return NULL;
 
-    for (j = 0; j < len - sep_len + 1; ++j) {
+    // Where is the next seperator?
+    while ((hit = ikstr_memmem(start, end - start, sep, sep_len)) != NULL) {
         // Is there room for the next element and the final element?
         if ( slots < elements + 2) {
             ikstr *tmp;
 
-            slots *= 2;
-            tmp = (ikstr*)iks_realloc(result, sizeof(ikstr) * slots);
+            tmp = (ikstr*)iks_realloc(result, sizeof(ikstr) * slots, sizeof(ikstr) * slots * 2);
             if (NULL == tmp)
                 goto cleanup;
             result = tmp;
+            slots *= 2;
         }
-        // Where is the seperator?
-        if ((sep_len == 1 && *(s+j) == sep[0]) || memcmp(s+j, sep, sep_len) == 0) {
-            result[elements] = ikstr_new_len(s + start, j - start);
-            if (result[elements] == NULL) goto cleanup;
-            ++elements;
-            start = j + sep_len;
-            j += sep_len - 1; // Skip the seperator
-        }
-
+        result[elements] = ikstr_new_len(start, hit - start);
+        if (result[elements] == NULL) goto cleanup;
+        ++elements;
+        start = hit + sep_len; // Skip the seperator
     }
-    result[elements] = ikstr_new_len(s + start, len - start);
+    result[elements] = ikstr_new_len(start, end - start);
     if (result[elements] == NULL) goto cleanup;
     ++elements;
     *count = elements;
@@ -304,7 +596,7 @@ ikstr* ikstr_split_len(const char *s, ssize_t len, const char *sep, int sep_len,
     cleanup:
     {
         for (int i = 0; i < elements; ++i) ikstr_free(result[i]);
-        iks_free(result);
+        iks_free_sized(result, sizeof(ikstr) * slots);
         *count = 0;
         return NULL;
     }
@@ -320,69 +612,212 @@ void ikstr_free_split_res(ikstr *tokens, int count) {
     iks_free(tokens);
 }
 
-ikstr ikstr_join(int argc, char **argv, const char *sep) {
-    ikstr s = ikstr_empty();
+/*
+ * Appends `count` strings separated by `sep` to `s` with at most one
+ * allocation: the total length is summed first, then everything is copied
+ * in one sweep. If `s` is NULL a new string of exactly the joined length is
+ * created. `argv` holds ikstr when `is_ikstr` is set, C strings otherwise.
+ */
+static ikstr ikstr_join_impl(ikstr s, size_t count, char **argv, int is_ikstr, const char *sep) {
+    size_t sep_len = NULL == sep ? 0 : strlen(sep), total = 0, len, n;
+    const char *old = s, *src;
+    char *p;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_JOIN);
+    for (size_t i = 0; i < count; ++i) {
+        n = is_ikstr ? ikstr_len(argv[i]) : strlen(argv[i]);
+        if (i) n += sep_len;
+        if (total + n < total) return NULL; // size_t overflow
+        total += n;
+    }
+
+    if (NULL == s) {
+        s = ikstr_new_len(IKSTR_NO_INIT, total);
+        if (NULL == s) return NULL ;
+        len = 0;
+    } else {
+        len = ikstr_len(s);
+        s = ikstr_make_room_for(s, total);
+        if (NULL == s) return NULL ;
+    }
 
-    for (int i = 0; i < argc; ++i) {
-        s = ikstr_concat(s, argv[i]);
-        if (i < argc - 1) s = ikstr_concat(s, sep);
+    p = s + len;
+    for (size_t i = 0; i < count; ++i) {
+        if (i && sep_len) {
+            memcpy(p, sep, sep_len);
+            p += sep_len;
+        }
+        src = argv[i];
+        if (NULL != old && src == old) {
+            // `s` itself, which ikstr_make_room_for may have moved; its old
+            // content is the first `len` bytes, its terminator may already
+            // be overwritten
+            const char *nul = memchr(s, '\0', len);
+
+            src = s;
+            n = is_ikstr || NULL == nul ? len : (size_t)(nul - s);
+        } else {
+            n = is_ikstr ? ikstr_len(argv[i]) : strlen(argv[i]);
+        }
+        memcpy(p, src, n);
+        p += n;
     }
+    *p = '\0';
+    IKSTR_STAT_ADD(bytes_copied, total);
+    ikstr_set_len(s, len + total);
     return s;
 }
 
+ikstr ikstr_join(int argc, char **argv, const char *sep) {
+    return ikstr_join_impl(NULL, argc > 0 ? (size_t)argc : 0, argv, 0, sep);
+}
+
 ikstr ikstr_join_ikstr(int argc, ikstr* argv, const char *sep) {
-    ikstr s = ikstr_empty();
+    return ikstr_join_impl(NULL, argc > 0 ? (size_t)argc : 0, argv, 1, sep);
+}
 
-    for (int i = 0; i < argc; ++i) {
-        s = ikstr_concat_ikstr(s, argv[i]);
-        if (i < argc - 1) s = ikstr_concat(s, sep);
-    }
-    return s;
+ikstr ikstr_join_n(size_t count, char **argv, const char *sep) {
+    return ikstr_join_impl(NULL, count, argv, 0, sep);
 }
 
-ikstr ikstr_make_room_for(ikstr s, size_t addlen) {
-    void *sh, *new_sh;
-    size_t avail = ikstr_avail(s);
-    size_t len, new_len, req_len;
-    char type, old_type = (char)(s[-1] & IKSTR_TYPE_MASK);
-    int hdr_len;
+ikstr ikstr_join_ikstr_n(size_t count, ikstr *argv, const char *sep) {
+    return ikstr_join_impl(NULL, count, argv, 1, sep);
+}
 
-    // No need to do anything
-    if (avail >= addlen) return s;
+ikstr ikstr_join_into(ikstr s, size_t count, char **argv, const char *sep) {
+    return ikstr_join_impl(s, count, argv, 0, sep);
+}
 
-    len = ikstr_len(s);
-    sh = (char*)s - ikstr_hdr_size(old_type);
-    req_len = new_len = (len + addlen);
+ikstr ikstr_join_ikstr_into(ikstr s, size_t count, ikstr *argv, const char *sep) {
+    return ikstr_join_impl(s, count, argv, 1, sep);
+}
 
-    if (new_len < IKSTR_PREALLOC)
-        new_len *= 2;
-    else
-        new_len += IKSTR_PREALLOC;
+static ikstr_growth ikstr_growth_cfg = {IKSTR_GROWTH_DEFAULT, 2.0, 0};
 
-    type = ikstr_req_type(new_len);
-    hdr_len = ikstr_hdr_size(type);
+void ikstr_set_growth(const ikstr_growth *g) {
+    static const ikstr_growth def = {IKSTR_GROWTH_DEFAULT, 2.0, 0};
 
-    if (hdr_len + new_len + 1 <= req_len) // size_t overflow
-        return NULL ;
+    ikstr_growth_cfg = g ? *g : def;
+    if (!(ikstr_growth_cfg.factor > 1.0)) ikstr_growth_cfg.factor = 2.0;
+}
+
+ikstr_growth ikstr_get_growth(void) {
+    return ikstr_growth_cfg;
+}
+
+size_t ikstr_grow_len(size_t cap, size_t req_len) {
+    double next;
+
+    switch (ikstr_growth_cfg.mode) {
+        case IKSTR_GROWTH_GEOMETRIC:
+            next = (double)cap * ikstr_growth_cfg.factor;
+            if (next >= (double)SIZE_MAX) return req_len;
+            return (size_t)next > req_len ? (size_t)next : req_len;
+        case IKSTR_GROWTH_EXACT:
+            return req_len;
+        default:
+            if (req_len < IKSTR_PREALLOC)
+                return req_len * 2;
+            return req_len + IKSTR_PREALLOC;
+    }
+}
 
-    if (old_type == type) {
-        new_sh = iks_realloc(sh, hdr_len + new_len + 1);
+/*
+ * Moves `s` into a heap block with a capacity of `new_cap` bytes, which must
+ * be at least its length. The block is resized in place when the header
+ * type stays the same and the memory is ours; otherwise the content is
+ * copied into a new block. With `fit_usable`, the capacity is raised to what
+ * the allocator actually handed out. With `narrow`, the header may also
+ * shrink to the smallest type that fits `new_cap`.
+ */
+static ikstr ikstr_set_capacity(ikstr s, size_t new_cap, int fit_usable, int narrow) {
+    void *sh, *new_sh;
+    size_t len = ikstr_len(s), cap = ikstr_cap(s), prefix = ikstr_prefix_size(s), block;
+    char type, old_type = (char)(s[-1] & IKSTR_TYPE_MASK);
+    int hdr_len, borrowed = s[-1] & IKSTR_FLAG_BORROWED, shared = s[-1] & IKSTR_FLAG_SHARED;
+
+    sh = (char*)s - prefix;
+    type = ikstr_req_type(new_cap);
+    // Unless asked to, never narrow the header: a wider one than needed (e.g.
+    // from ikstr_new_growable) is kept so the block can be resized in place
+    if (type < old_type && !narrow) type = old_type;
+    hdr_len = ikstr_hdr_size(type);
+
+    if (old_type == type && !borrowed) {
+        // Same layout, including the reference count of a shared string
+        // (the caller holds its only reference)
+        hdr_len = (int)prefix;
+        block = hdr_len + new_cap + 1;
+        if (block <= new_cap) // size_t overflow
+            return NULL ;
+        new_sh = iks_realloc(sh, prefix + cap + 1, block);
         // ReSharper disable once CppDFAMemoryLeak
         if (NULL == new_sh) return NULL ;
         s = (char*)new_sh + hdr_len;
     }
     else {
-        new_sh = iks_malloc(hdr_len + new_len + 1);
+        // Header width changes or the memory is not ours to realloc: move.
+        // A shared string keeps its extension, so it can still be retained
+        if (shared) hdr_len += (int)sizeof(struct ikstr_ext);
+        block = hdr_len + new_cap + 1;
+        if (block <= new_cap) // size_t overflow
+            return NULL ;
+        new_sh = iks_malloc(block);
         // ReSharper disable once CppDFAMemoryLeak
-        if (NULL == s) return NULL ;
+        if (NULL == new_sh) return NULL ;
         memcpy((char*) new_sh + hdr_len, s, len + 1);
-        iks_free(sh);
+        IKSTR_STAT_ADD(bytes_copied, len);
+        if (type != old_type) IKSTR_STAT_ADD(migrations, 1);
+        if (!borrowed) iks_free_sized(sh, prefix + cap + 1);
 
         s = (char*)new_sh + hdr_len;
-        s[-1] = type;
+        s[-1] = (char)(type | shared);
+        if (shared) ikstr_ext_of(s)->refs = 1;
         ikstr_set_len(s, len);
     }
-    ikstr_set_cap(s, new_len);
+    if (fit_usable) {
+        size_t max = ikstr_type_max(type);
+        new_cap = iks_usable_size(new_sh, block) - hdr_len - 1;
+        if (new_cap > max) new_cap = max;
+    }
+    ikstr_set_cap(s, new_cap);
     // ReSharper disable once CppDFAMemoryLeak
     return s;
-}
\ No newline at end of file
+}
+
+ikstr ikstr_make_room_for(ikstr s, size_t addlen) {
+    size_t len, req_len, new_len;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_MAKE_ROOM);
+    s = ikstr_unshare(s, addlen);
+    if (NULL == s) return NULL ;
+    // No need to do anything
+    if (ikstr_avail(s) >= addlen) return s;
+
+    len = ikstr_len(s);
+    req_len = len + addlen;
+    if (req_len < len) // size_t overflow
+        return NULL ;
+    new_len = ikstr_grow_len(ikstr_cap(s), req_len);
+    s = ikstr_set_capacity(s, new_len, ikstr_growth_cfg.usable_size, 0);
+    if (s) IKSTR_STAT_ADD(slack_bytes, ikstr_cap(s) - req_len);
+    return s;
+}
+
+ikstr ikstr_reserve(ikstr s, size_t cap) {
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+    if (ikstr_cap(s) >= cap) return s;
+    return ikstr_set_capacity(s, cap, ikstr_growth_cfg.usable_size, 0);
+}
+
+ikstr ikstr_shrink_to_fit(ikstr s) {
+    size_t len = ikstr_len(s);
+
+    if (s[-1] & IKSTR_FLAG_MAPPED) return s; // nothing to give back
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL ;
+    if (s[-1] & IKSTR_FLAG_BORROWED) return s;
+    if (ikstr_cap(s) == len && (s[-1] & IKSTR_TYPE_MASK) == ikstr_req_type(len)) return s;
+    return ikstr_set_capacity(s, len, 0, 1);
+}
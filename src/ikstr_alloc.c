@@ -0,0 +1,125 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(__GLIBC__)
+#   include <malloc.h>
+#elif defined(__APPLE__)
+#   include <malloc/malloc.h>
+#elif defined(_MSC_VER)
+#   include <malloc.h>
+#endif
+
+static void *ikstr_libc_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    return malloc(size);
+}
+
+static void *ikstr_libc_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void ikstr_libc_release(void *ctx, void *ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+static size_t ikstr_libc_usable_size(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+#if defined(__GLIBC__)
+    (void)size;
+    return malloc_usable_size(ptr);
+#elif defined(__APPLE__)
+    (void)size;
+    return malloc_size(ptr);
+#elif defined(_MSC_VER)
+    (void)size;
+    return _msize(ptr);
+#else
+    (void)ptr;
+    return size;
+#endif
+}
+
+const ikstr_allocator ikstr_libc_allocator = {
+    ikstr_libc_alloc,
+    ikstr_libc_resize,
+    ikstr_libc_release,
+    NULL,
+    NULL,
+    ikstr_libc_usable_size,
+};
+
+static const ikstr_allocator *ikstr_global_allocator = &ikstr_libc_allocator;
+static IKSTR_THREAD_LOCAL const ikstr_allocator *ikstr_thread_allocator = NULL;
+
+void ikstr_set_allocator(const ikstr_allocator *a) {
+    ikstr_global_allocator = a ? a : &ikstr_libc_allocator;
+}
+
+void ikstr_set_thread_allocator(const ikstr_allocator *a) {
+    ikstr_thread_allocator = a;
+}
+
+const ikstr_allocator *ikstr_get_allocator(void) {
+    return ikstr_thread_allocator ? ikstr_thread_allocator : ikstr_global_allocator;
+}
+
+void *iks_malloc(size_t size) {
+    const ikstr_allocator *a = ikstr_get_allocator();
+
+    IKSTR_STAT_ADD(allocs, 1);
+    IKSTR_STAT_ADD(alloc_bytes, size);
+    return a->alloc(a->ctx, size);
+}
+
+void *iks_realloc(void *ptr, size_t old_size, size_t new_size) {
+    const ikstr_allocator *a = ikstr_get_allocator();
+    void *p;
+
+    IKSTR_STAT_ADD(reallocs, 1);
+    IKSTR_STAT_ADD(alloc_bytes, new_size);
+    if (NULL == ptr) return a->alloc(a->ctx, new_size);
+    if (a->resize) return a->resize(a->ctx, ptr, old_size, new_size);
+
+    p = a->alloc(a->ctx, new_size);
+    if (NULL == p) return NULL;
+    memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    if (a->release_sized) a->release_sized(a->ctx, ptr, old_size);
+    else a->release(a->ctx, ptr);
+    return p;
+}
+
+void iks_free(void *ptr) {
+    const ikstr_allocator *a;
+
+    if (NULL == ptr) return;
+    IKSTR_STAT_ADD(frees, 1);
+    a = ikstr_get_allocator();
+    a->release(a->ctx, ptr);
+}
+
+void iks_free_sized(void *ptr, size_t size) {
+    const ikstr_allocator *a;
+
+    if (NULL == ptr) return;
+    IKSTR_STAT_ADD(frees, 1);
+    a = ikstr_get_allocator();
+    if (a->release_sized) a->release_sized(a->ctx, ptr, size);
+    else a->release(a->ctx, ptr);
+}
+
+size_t iks_usable_size(void *ptr, size_t size) {
+    const ikstr_allocator *a = ikstr_get_allocator();
+    size_t real;
+
+    if (NULL == a->usable_size) return size;
+    real = a->usable_size(a->ctx, ptr, size);
+    return real > size ? real : size;
+}
@@ -0,0 +1,212 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_arena.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct ikstr_arena_block {
+    struct ikstr_arena_block *next;
+    size_t size;
+    size_t used;
+    char data[];
+};
+
+struct ikstr_arena {
+    size_t block_size;
+    struct ikstr_arena_block *head; // regular blocks, kept across resets
+    struct ikstr_arena_block *cur;  // block currently bumped from
+    struct ikstr_arena_block *big;  // oversized blocks, freed on reset
+};
+
+static struct ikstr_arena_block *ikstr_arena_block_new(size_t size) {
+    struct ikstr_arena_block *b = iks_malloc(sizeof(struct ikstr_arena_block) + size);
+    if (NULL == b) return NULL;
+    b->next = NULL;
+    b->size = size;
+    b->used = 0;
+    return b;
+}
+
+static void *ikstr_arena_alloc(ikstr_arena *a, size_t n) {
+    struct ikstr_arena_block *b = a->cur;
+
+    if (b && b->size - b->used >= n) {
+        b->used += n;
+        return b->data + b->used - n;
+    }
+
+    // Too large for a regular block: give it a block of its own
+    if (n > a->block_size) {
+        b = ikstr_arena_block_new(n);
+        if (NULL == b) return NULL;
+        b->used = n;
+        b->next = a->big;
+        a->big = b;
+        return b->data;
+    }
+
+    // Blocks after `cur` are empty leftovers of a previous reset
+    if (b && b->next) {
+        b = b->next;
+    } else {
+        struct ikstr_arena_block *nb = ikstr_arena_block_new(a->block_size);
+        if (NULL == nb) return NULL;
+        if (b) b->next = nb;
+        else a->head = nb;
+        b = nb;
+    }
+    a->cur = b;
+    b->used = n;
+    return b->data;
+}
+
+/*
+ * Carves an arena string with room for `cap` bytes and sets its header.
+ * The payload is left untouched.
+ */
+static ikstr ikstr_arena_alloc_str(ikstr_arena *a, size_t len, size_t cap) {
+    unsigned char type = ikstr_req_type(cap);
+    int hdr_len = ikstr_hdr_size(type);
+    ikstr s;
+    char *sh;
+
+    if (hdr_len + cap + 1 <= cap) // size_t overflow
+        return NULL;
+    sh = ikstr_arena_alloc(a, hdr_len + cap + 1);
+    if (NULL == sh) return NULL;
+    s = sh + hdr_len;
+    ikstr_init_hdr(s, type | IKSTR_FLAG_BORROWED, len, cap);
+    return s;
+}
+
+ikstr_arena *ikstr_arena_create(size_t block_size) {
+    ikstr_arena *a = iks_malloc(sizeof(ikstr_arena));
+    if (NULL == a) return NULL;
+    a->block_size = block_size ? block_size : IKSTR_ARENA_BLOCK;
+    a->head = a->cur = a->big = NULL;
+    return a;
+}
+
+void ikstr_arena_reset(ikstr_arena *a) {
+    struct ikstr_arena_block *b, *next;
+
+    if (NULL == a) return;
+    for (b = a->big; b; b = next) {
+        next = b->next;
+        iks_free_sized(b, sizeof(struct ikstr_arena_block) + b->size);
+    }
+    a->big = NULL;
+    for (b = a->head; b; b = b->next) b->used = 0;
+    a->cur = a->head;
+}
+
+void ikstr_arena_destroy(ikstr_arena *a) {
+    struct ikstr_arena_block *b, *next;
+
+    if (NULL == a) return;
+    ikstr_arena_reset(a);
+    for (b = a->head; b; b = next) {
+        next = b->next;
+        iks_free_sized(b, sizeof(struct ikstr_arena_block) + b->size);
+    }
+    iks_free_sized(a, sizeof(ikstr_arena));
+}
+
+size_t ikstr_arena_used(const ikstr_arena *a) {
+    const struct ikstr_arena_block *b;
+    size_t used = 0;
+
+    for (b = a->big; b; b = b->next) used += b->used;
+    for (b = a->head; b; b = b->next) {
+        used += b->used;
+        if (b == a->cur) break;
+    }
+    return used;
+}
+
+ikstr ikstr_arena_new_len(ikstr_arena *a, const void *init, size_t init_len) {
+    ikstr s = ikstr_arena_alloc_str(a, init_len, init_len);
+
+    if (NULL == s) return NULL;
+    if (init == IKSTR_NO_INIT) init = 0;
+    else if (!init) memset(s, 0, init_len);
+    if (init_len && init) memcpy(s, init, init_len);
+    s[init_len] = '\0';
+    return s;
+}
+
+ikstr ikstr_arena_new(ikstr_arena *a, const char *init) {
+    size_t len = NULL == init ? 0 : strlen(init);
+    return ikstr_arena_new_len(a, init, len);
+}
+
+ikstr ikstr_arena_empty(ikstr_arena *a) {
+    return ikstr_arena_new_len(a, "", 0);
+}
+
+ikstr ikstr_arena_dup(ikstr_arena *a, ikstr s) {
+    return ikstr_arena_new_len(a, s, ikstr_len(s));
+}
+
+ikstr ikstr_arena_make_room_for(ikstr_arena *a, ikstr s, size_t addlen) {
+    struct ikstr_arena_block *b = a->cur;
+    unsigned char flags;
+    size_t len, cap, req_len, new_len;
+    ikstr t;
+
+    // Heap strings passed in may be shared or carry a cached hash
+    s = ikstr_unshare(s, 0);
+    if (NULL == s) return NULL;
+    flags = s[-1];
+
+    // No need to do anything
+    if (ikstr_avail(s) >= addlen) return s;
+
+    len = ikstr_len(s);
+    cap = ikstr_cap(s);
+    req_len = len + addlen;
+    if (req_len < len) // size_t overflow
+        return NULL;
+    new_len = ikstr_grow_len(cap, req_len);
+
+    // Last allocation of the current block: just move the bump pointer
+    if ((flags & IKSTR_FLAG_BORROWED) && b && s + cap + 1 == b->data + b->used &&
+        (flags & IKSTR_TYPE_MASK) == ikstr_req_type(new_len)) {
+        size_t room = b->size - b->used;
+
+        if (room >= req_len - cap) {
+            if (new_len - cap > room) new_len = cap + room;
+            b->used += new_len - cap;
+            ikstr_set_cap(s, new_len);
+            return s;
+        }
+    }
+
+    t = ikstr_arena_alloc_str(a, len, new_len);
+    if (NULL == t) return NULL;
+    memcpy(t, s, len + 1);
+    ikstr_free(s); // no-op for borrowed strings
+    return t;
+}
+
+ikstr ikstr_arena_concat_len(ikstr_arena *a, ikstr s, const void *t, size_t len) {
+    size_t l = ikstr_len(s);
+    s = ikstr_arena_make_room_for(a, s, len);
+    if (NULL == s) return NULL;
+    memcpy(s + l, t, len);
+    ikstr_set_len(s, l + len);
+    s[l + len] = '\0';
+    return s;
+}
+
+ikstr ikstr_arena_concat(ikstr_arena *a, ikstr s, const char *t) {
+    return ikstr_arena_concat_len(a, s, t, strlen(t));
+}
+
+ikstr ikstr_arena_concat_ikstr(ikstr_arena *a, ikstr s, ikstr t) {
+    return ikstr_arena_concat_len(a, s, t, ikstr_len(t));
+}
@@ -0,0 +1,199 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_builder.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * `len` is only kept up to date for chunks before the tail; the tail is
+ * filled up to the builder's `pos`.
+ */
+struct ikstr_builder_chunk {
+    struct ikstr_builder_chunk *next;
+    size_t len;
+    size_t cap;
+    char data[];
+};
+
+/*
+ * Empty tail of a builder without chunks, so `end - pos` is 0 instead of a
+ * subtraction of null pointers. Nothing is ever written to it.
+ */
+static char ikstr_builder_none[1];
+
+void ikstr_builder_init(ikstr_builder *b, size_t chunk_size) {
+    b->pos = b->end = ikstr_builder_none;
+    b->len = 0;
+    b->head = b->tail = NULL;
+    b->chunks = 0;
+    b->chunk_size = chunk_size ? chunk_size : IKSTR_BUILDER_CHUNK;
+}
+
+static void ikstr_builder_free_list(struct ikstr_builder_chunk *c) {
+    while (c) {
+        struct ikstr_builder_chunk *next = c->next;
+        iks_free_sized(c, sizeof(struct ikstr_builder_chunk) + c->cap);
+        c = next;
+    }
+}
+
+void ikstr_builder_reset(ikstr_builder *b) {
+    struct ikstr_builder_chunk *c = b->head;
+
+    if (NULL == c) return;
+    ikstr_builder_free_list(c->next);
+    c->next = NULL;
+    b->tail = c;
+    b->pos = c->data;
+    b->end = c->data + c->cap;
+    b->len = 0;
+    b->chunks = 1;
+}
+
+void ikstr_builder_free(ikstr_builder *b) {
+    ikstr_builder_free_list(b->head);
+    ikstr_builder_init(b, b->chunk_size);
+}
+
+/*
+ * Links a new chunk with room for at least `need` bytes after the tail and
+ * makes it the tail. Each chunk is twice the size of the previous one, up
+ * to IKSTR_BUILDER_MAX_CHUNK.
+ */
+static int ikstr_builder_grow(ikstr_builder *b, size_t need) {
+    size_t cap = b->chunk_size;
+    struct ikstr_builder_chunk *c;
+
+    if (b->tail) {
+        cap = b->tail->cap < IKSTR_BUILDER_MAX_CHUNK / 2 ? b->tail->cap * 2 : IKSTR_BUILDER_MAX_CHUNK;
+        if (cap < b->chunk_size) cap = b->chunk_size;
+    }
+    if (cap < need) cap = need;
+    if (cap > SIZE_MAX - sizeof(struct ikstr_builder_chunk)) return 0;
+    c = iks_malloc(sizeof(struct ikstr_builder_chunk) + cap);
+    if (NULL == c) return 0;
+
+    c->next = NULL;
+    c->len = 0;
+    c->cap = cap;
+    if (b->tail) {
+        b->tail->len = (size_t)(b->pos - b->tail->data);
+        b->tail->next = c;
+    } else {
+        b->head = c;
+    }
+    b->tail = c;
+    b->pos = c->data;
+    b->end = c->data + cap;
+    b->chunks++;
+    return 1;
+}
+
+int ikstr_builder_append_slow(ikstr_builder *b, const void *p, size_t len) {
+    size_t n = (size_t)(b->end - b->pos);
+
+    // Fill what is left of the tail, the rest goes into one new chunk
+    if (n) memcpy(b->pos, p, n);
+    b->pos += n;
+    if (!ikstr_builder_grow(b, len - n)) {
+        b->pos -= n;
+        return -1;
+    }
+    memcpy(b->pos, (const char *)p + n, len - n);
+    b->pos += len - n;
+    b->len += len;
+    return 0;
+}
+
+int ikstr_builder_append(ikstr_builder *b, const char *t) {
+    return ikstr_builder_append_len(b, t, strlen(t));
+}
+
+int ikstr_builder_append_ikstr(ikstr_builder *b, ikstr t) {
+    return ikstr_builder_append_len(b, t, ikstr_len(t));
+}
+
+int ikstr_builder_append_int(ikstr_builder *b, long long v) {
+    // Negate in unsigned arithmetic so LLONG_MIN does not overflow
+    uint64_t u = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    size_t n = ikstr_u64_digits(u) + (v < 0 ? 1 : 0);
+
+    if (n > (size_t)(b->end - b->pos) && !ikstr_builder_grow(b, n)) return -1;
+    if (v < 0) b->pos[0] = '-';
+    ikstr_u64_write(b->pos + n, u);
+    b->pos += n;
+    b->len += n;
+    return 0;
+}
+
+int ikstr_builder_append_vfmt(ikstr_builder *b, const char *fmt, va_list ap) {
+    size_t room = (size_t)(b->end - b->pos);
+    va_list ap2;
+    char tmp[1];
+    int n;
+
+    // Format straight into the tail; vsnprintf needs a byte for the
+    // terminator, which is not kept
+    va_copy(ap2, ap);
+    n = room ? vsnprintf(b->pos, room, fmt, ap2) : vsnprintf(tmp, 1, fmt, ap2);
+    va_end(ap2);
+    if (n < 0) return -1;
+
+    // Did not fit: format the whole text again into a new chunk
+    if ((size_t)n >= room) {
+        if (!ikstr_builder_grow(b, (size_t)n + 1)) return -1;
+        va_copy(ap2, ap);
+        n = vsnprintf(b->pos, (size_t)n + 1, fmt, ap2);
+        va_end(ap2);
+        if (n < 0) return -1;
+    }
+    b->pos += n;
+    b->len += (size_t)n;
+    return 0;
+}
+
+int ikstr_builder_append_fmt(ikstr_builder *b, const char *fmt, ...) {
+    va_list ap;
+    int r;
+
+    va_start(ap, fmt);
+    r = ikstr_builder_append_vfmt(b, fmt, ap);
+    va_end(ap);
+    return r;
+}
+
+ikstr ikstr_builder_finish(ikstr_builder *b) {
+    ikstr s = ikstr_new_len(IKSTR_NO_INIT, b->len);
+    char *p = s;
+
+    if (NULL == s) return NULL;
+    for (struct ikstr_builder_chunk *c = b->head; c; c = c->next) {
+        size_t len = c == b->tail ? (size_t)(b->pos - c->data) : c->len;
+        memcpy(p, c->data, len);
+        p += len;
+    }
+    ikstr_builder_reset(b);
+    return s;
+}
+
+#if !defined(_WIN32)
+size_t ikstr_builder_to_iovec(const ikstr_builder *b, struct iovec *iov, size_t max) {
+    size_t n = 0;
+
+    for (struct ikstr_builder_chunk *c = b->head; c; c = c->next) {
+        size_t len = c == b->tail ? (size_t)(b->pos - c->data) : c->len;
+
+        if (len == 0) continue;
+        if (n < max) {
+            iov[n].iov_base = c->data;
+            iov[n].iov_len = len;
+        }
+        ++n;
+    }
+    return n;
+}
+#endif
@@ -0,0 +1,338 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#   define _DEFAULT_SOURCE // MAP_ANONYMOUS
+#endif
+#include "ikstr_file.h"
+#include "ikstr_internal.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#if !defined(_WIN32)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/uio.h>
+#   include <limits.h>
+#   include <unistd.h>
+#   if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#       define MAP_ANONYMOUS MAP_ANON
+#   endif
+#   define IKSTR_IOV_BATCH 256 // strings per writev call
+#   if defined(IOV_MAX) && IOV_MAX < IKSTR_IOV_BATCH
+#       undef IKSTR_IOV_BATCH
+#       define IKSTR_IOV_BATCH IOV_MAX
+#   endif
+#endif
+
+#if !defined(_WIN32)
+
+static size_t ikstr_page_size(void) {
+    static size_t page;
+
+    if (0 == page) page = (size_t)sysconf(_SC_PAGESIZE);
+    return page;
+}
+
+/*
+ * Bytes mapped for a file of `len` bytes: the header page, then the file
+ * rounded up to whole pages with room for the terminator. Bytes past the end
+ * of the file are zero, in the last file page as in the anonymous page that
+ * follows a file ending on a page boundary.
+ */
+static size_t ikstr_map_span(size_t len) {
+    size_t page = ikstr_page_size();
+    return page + ((len + page) & ~(page - 1));
+}
+
+ikstr ikstr_map_file(const char *path) {
+    size_t page = ikstr_page_size(), len, span;
+    struct stat st;
+    char *base;
+    ikstr s;
+    int fd, err;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    if (fstat(fd, &st) != 0) goto fail;
+    if (!S_ISREG(st.st_mode)) {
+        errno = EINVAL;
+        goto fail;
+    }
+    if ((uintmax_t)st.st_size > SIZE_MAX - 2 * page) {
+        errno = EFBIG;
+        goto fail;
+    }
+    len = (size_t)st.st_size;
+    if (len == 0) {
+        close(fd);
+        return ikstr_empty();
+    }
+
+    // Reserve the whole span as zeroed memory, then put the file over it
+    span = ikstr_map_span(len);
+    base = mmap(NULL, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == base) goto fail;
+    if (MAP_FAILED == mmap(base + page, len, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0)) {
+        err = errno;
+        munmap(base, span);
+        errno = err;
+        goto fail;
+    }
+    close(fd);
+
+    s = base + page;
+    ikstr_init_hdr(s, (unsigned char)(ikstr_req_type(len) | IKSTR_FLAG_MAPPED), len, len);
+    return s;
+
+    fail:
+    err = errno;
+    close(fd);
+    errno = err;
+    return NULL;
+}
+
+void ikstr_unmap(ikstr s) {
+    size_t page = ikstr_page_size();
+    munmap((char *)s - page, ikstr_map_span(ikstr_len(s)));
+}
+
+ssize_t ikstr_read_fd(ikstr *s, int fd, size_t max) {
+    ikstr t = *s;
+    size_t len = ikstr_len(t);
+    ssize_t n;
+
+    if (0 == max) max = ikstr_avail(t) > IKSTR_IO_CHUNK ? ikstr_avail(t) : IKSTR_IO_CHUNK;
+    t = ikstr_make_room_for(t, max);
+    if (NULL == t) {
+        errno = ENOMEM;
+        return -1;
+    }
+    *s = t;
+    if (max > SSIZE_MAX) max = SSIZE_MAX;
+
+    do {
+        n = read(fd, t + len, max);
+    } while (n < 0 && EINTR == errno);
+    if (n > 0) {
+        t[len + (size_t)n] = '\0';
+        ikstr_set_len(t, len + (size_t)n);
+    }
+    return n;
+}
+
+ikstr ikstr_read_file(const char *path) {
+    struct stat st;
+    ikstr s;
+    ssize_t n;
+    int fd, err;
+
+    fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    // One byte more than the size, so the read that sees the end of the
+    // file does not need to grow the string
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && (uintmax_t)st.st_size < SIZE_MAX)
+        s = ikstr_reserve(ikstr_empty(), (size_t)st.st_size + 1);
+    else
+        s = ikstr_empty();
+    if (NULL == s) {
+        close(fd);
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    while ((n = ikstr_read_fd(&s, fd, ikstr_avail(s))) > 0);
+    err = errno;
+    close(fd);
+    if (n < 0) {
+        ikstr_free(s);
+        errno = err;
+        return NULL;
+    }
+    return s;
+}
+
+ssize_t ikstr_write_fd(int fd, ikstr s) {
+    size_t len = ikstr_len(s), done = 0;
+
+    while (done < len) {
+        size_t chunk = len - done > SSIZE_MAX ? SSIZE_MAX : len - done;
+        ssize_t n = write(fd, s + done, chunk);
+
+        if (n <= 0) {
+            if (n < 0 && EINTR == errno) continue;
+            // Writing nothing would never make progress
+            if (0 == n) errno = EIO;
+            return done ? (ssize_t)done : -1;
+        }
+        done += (size_t)n;
+    }
+    return (ssize_t)done;
+}
+
+ssize_t ikstr_writev_many(int fd, const ikstr *strs, size_t count) {
+    struct iovec iov[IKSTR_IOV_BATCH];
+    size_t i = 0, off = 0, done = 0; // next byte to write: strs[i] + off
+
+    for (;;) {
+        size_t k = 0, bytes = 0;
+        ssize_t n;
+
+        // Skip finished and empty strings, then describe the next batch
+        while (i < count && off == ikstr_len(strs[i])) {
+            ++i;
+            off = 0;
+        }
+        for (size_t j = i; j < count && k < IKSTR_IOV_BATCH; ++j) {
+            size_t from = j == i ? off : 0, len = ikstr_len(strs[j]) - from;
+
+            if (0 == len) continue;
+            if (len > SSIZE_MAX - bytes) break;
+            iov[k].iov_base = strs[j] + from;
+            iov[k].iov_len = len;
+            bytes += len;
+            ++k;
+        }
+        if (0 == k) return (ssize_t)done;
+
+        n = writev(fd, iov, (int)k);
+        if (n <= 0) {
+            if (n < 0 && EINTR == errno) continue;
+            if (0 == n) errno = EIO;
+            return done ? (ssize_t)done : -1;
+        }
+        done += (size_t)n;
+
+        // Advance past what was written, possibly in the middle of a string
+        while (n > 0) {
+            size_t left = ikstr_len(strs[i]) - off;
+
+            if ((size_t)n < left) {
+                off += (size_t)n;
+                break;
+            }
+            n -= (ssize_t)left;
+            ++i;
+            off = 0;
+        }
+    }
+}
+
+void ikstr_line_reader_init(ikstr_line_reader *lr, int fd) {
+    lr->buf = NULL;
+    lr->pos = 0;
+    lr->scanned = 0;
+    lr->fd = fd;
+    lr->eof = 0;
+}
+
+/*
+ * Reads more input behind the unconsumed bytes. Consumed bytes are dropped
+ * here, and only moved when the tail has no room for a full read.
+ */
+static ssize_t ikstr_line_reader_fill(ikstr_line_reader *lr) {
+    size_t len;
+
+    if (NULL == lr->buf) {
+        lr->buf = ikstr_reserve(ikstr_empty(), IKSTR_LINE_READ);
+        if (NULL == lr->buf) {
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+    len = ikstr_len(lr->buf);
+    if (lr->pos == len) {
+        len = 0;
+        lr->pos = 0;
+    } else if (lr->pos > 0 && ikstr_avail(lr->buf) < IKSTR_LINE_READ) {
+        len -= lr->pos;
+        memmove(lr->buf, lr->buf + lr->pos, len);
+        lr->pos = 0;
+    }
+    lr->buf[len] = '\0';
+    ikstr_set_len(lr->buf, len);
+
+    return ikstr_read_fd(&lr->buf, lr->fd,
+                         ikstr_avail(lr->buf) > IKSTR_LINE_READ ? ikstr_avail(lr->buf) : IKSTR_LINE_READ);
+}
+
+int ikstr_line_reader_next(ikstr_line_reader *lr, ikstr_view *line) {
+    for (;;) {
+        const char *start = lr->buf ? lr->buf + lr->pos : NULL;
+        size_t have = lr->buf ? ikstr_len(lr->buf) - lr->pos : 0;
+        const char *nl = have > lr->scanned ? memchr(start + lr->scanned, '\n', have - lr->scanned) : NULL;
+        ssize_t n;
+
+        if (nl) {
+            line->ptr = start;
+            line->len = (size_t)(nl - start);
+            lr->pos += line->len + 1;
+            lr->scanned = 0;
+            return 1;
+        }
+        // Bytes already searched are not searched again after the refill
+        lr->scanned = have;
+        if (lr->eof) {
+            if (0 == have) return 0;
+            line->ptr = start;
+            line->len = have;
+            lr->pos += have;
+            lr->scanned = 0;
+            return 1;
+        }
+        n = ikstr_line_reader_fill(lr);
+        if (n < 0) return -1;
+        if (0 == n) lr->eof = 1;
+    }
+}
+
+void ikstr_line_reader_free(ikstr_line_reader *lr) {
+    ikstr_free(lr->buf);
+    lr->buf = NULL;
+}
+
+#else
+
+ikstr ikstr_read_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    ikstr s = ikstr_empty();
+    size_t n;
+
+    if (NULL == f || NULL == s) {
+        if (f) fclose(f);
+        ikstr_free(s);
+        return NULL;
+    }
+    do {
+        size_t len = ikstr_len(s);
+        ikstr t = ikstr_make_room_for(s, 16384);
+
+        if (NULL == t) {
+            ikstr_free(s);
+            fclose(f);
+            return NULL;
+        }
+        s = t;
+        n = fread(s + len, 1, ikstr_avail(s), f);
+        s[len + n] = '\0';
+        ikstr_set_len(s, len + n);
+    } while (n > 0);
+    if (ferror(f)) {
+        ikstr_free(s);
+        s = NULL;
+    }
+    fclose(f);
+    return s;
+}
+
+ikstr ikstr_map_file(const char *path) {
+    return ikstr_read_file(path);
+}
+
+void ikstr_unmap(ikstr s) {
+    (void)s; // strings are never mapped here
+}
+
+#endif
@@ -0,0 +1,143 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_internal.h"
+#include "ikstr_alloc.h"
+#include <string.h>
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#endif
+
+/*
+ * wyhash (final version 4), by Wang Yi, released into the public domain.
+ * Reads are done in native byte order, so hashes differ between little and
+ * big endian machines; they are never stored.
+ */
+
+static const uint64_t ikstr_wyp[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+static inline void ikstr_wymum(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = *a;
+    r *= *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b, hi, lo;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t ikstr_wymix(uint64_t a, uint64_t b) {
+    ikstr_wymum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t ikstr_wyr8(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint64_t ikstr_wyr4(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t ikstr_wyr3(const unsigned char *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t ikstr_hash_bytes(const void *key, size_t len, uint64_t seed) {
+    const unsigned char *p = key;
+    const uint64_t *s = ikstr_wyp;
+    uint64_t a, b;
+
+    seed ^= ikstr_wymix(seed ^ s[0], s[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (ikstr_wyr4(p) << 32) | ikstr_wyr4(p + ((len >> 3) << 2));
+            b = (ikstr_wyr4(p + len - 4) << 32) | ikstr_wyr4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = ikstr_wyr3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i >= 48) {
+            // Three independent lanes keep the multipliers busy
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = ikstr_wymix(ikstr_wyr8(p) ^ s[1], ikstr_wyr8(p + 8) ^ seed);
+                see1 = ikstr_wymix(ikstr_wyr8(p + 16) ^ s[2], ikstr_wyr8(p + 24) ^ see1);
+                see2 = ikstr_wymix(ikstr_wyr8(p + 32) ^ s[3], ikstr_wyr8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = ikstr_wymix(ikstr_wyr8(p) ^ s[1], ikstr_wyr8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = ikstr_wyr8(p + i - 16);
+        b = ikstr_wyr8(p + i - 8);
+    }
+    a ^= s[1];
+    b ^= seed;
+    ikstr_wymum(&a, &b);
+    return ikstr_wymix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+uint64_t ikstr_hash_len(const void *p, size_t len) {
+    return ikstr_hash_bytes(p, len, 0);
+}
+
+uint64_t ikstr_hash(ikstr s) {
+    unsigned char flags = (unsigned char)s[-1];
+    struct ikstr_ext *ext;
+    uint64_t h;
+
+    if (!(flags & IKSTR_FLAG_SHARED)) return ikstr_hash_bytes(s, ikstr_len(s), 0);
+    ext = ikstr_ext_of(s);
+    if (flags & IKSTR_FLAG_HASHED) return ext->hash;
+
+    h = ikstr_hash_bytes(s, ikstr_len(s), 0);
+    // Other references may be reading the flags concurrently
+    if (ikstr_ref_load(&ext->refs) == 1) {
+        ext->hash = h;
+        s[-1] = (char)(flags | IKSTR_FLAG_HASHED);
+    }
+    return h;
+}
+
+ikstr ikstr_cache_hash(ikstr s) {
+    ikstr t = s;
+
+    if (!(s[-1] & IKSTR_FLAG_SHARED)) {
+        t = ikstr_new_shared_len(s, ikstr_len(s));
+        if (NULL == t) return NULL;
+        ikstr_free(s);
+    } else if (s[-1] & IKSTR_FLAG_HASHED) {
+        return s;
+    } else if (ikstr_ref_load(&ikstr_ext_of(s)->refs) > 1) {
+        return s; // cannot be written safely, ikstr_hash computes it each time
+    }
+    ikstr_ext_of(t)->hash = ikstr_hash_bytes(t, ikstr_len(t), 0);
+    t[-1] = (char)(t[-1] | IKSTR_FLAG_HASHED);
+    return t;
+}
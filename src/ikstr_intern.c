@@ -0,0 +1,186 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#   define _POSIX_C_SOURCE 200809L // pthread_rwlock_t
+#endif
+#include "ikstr_intern.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+#if defined(_WIN32)
+#   include <windows.h>
+typedef SRWLOCK ikstr_rwlock;
+#   define ikstr_rwlock_init(l) InitializeSRWLock(l)
+#   define ikstr_rwlock_destroy(l) ((void)(l))
+#   define ikstr_rwlock_rdlock(l) AcquireSRWLockShared(l)
+#   define ikstr_rwlock_rdunlock(l) ReleaseSRWLockShared(l)
+#   define ikstr_rwlock_wrlock(l) AcquireSRWLockExclusive(l)
+#   define ikstr_rwlock_wrunlock(l) ReleaseSRWLockExclusive(l)
+#else
+#   include <pthread.h>
+typedef pthread_rwlock_t ikstr_rwlock;
+#   define ikstr_rwlock_init(l) pthread_rwlock_init(l, NULL)
+#   define ikstr_rwlock_destroy(l) pthread_rwlock_destroy(l)
+#   define ikstr_rwlock_rdlock(l) pthread_rwlock_rdlock(l)
+#   define ikstr_rwlock_rdunlock(l) pthread_rwlock_unlock(l)
+#   define ikstr_rwlock_wrlock(l) pthread_rwlock_wrlock(l)
+#   define ikstr_rwlock_wrunlock(l) pthread_rwlock_unlock(l)
+#endif
+
+#define IKSTR_INTERN_MIN_SLOTS 64
+
+struct ikstr_intern_slot {
+    uint64_t hash;
+    ikstr s;        // NULL for an empty slot
+};
+
+struct ikstr_intern_pool {
+    struct ikstr_intern_slot *slots;
+    size_t mask;    // number of slots - 1, a power of two minus one
+    size_t count;
+    int flags;
+    ikstr_rwlock lock;
+};
+
+ikstr_intern_pool *ikstr_intern_pool_create(int flags) {
+    ikstr_intern_pool *p = iks_malloc(sizeof(ikstr_intern_pool));
+
+    if (NULL == p) return NULL;
+    p->slots = iks_malloc(sizeof(struct ikstr_intern_slot) * IKSTR_INTERN_MIN_SLOTS);
+    if (NULL == p->slots) {
+        iks_free_sized(p, sizeof(ikstr_intern_pool));
+        return NULL;
+    }
+    memset(p->slots, 0, sizeof(struct ikstr_intern_slot) * IKSTR_INTERN_MIN_SLOTS);
+    p->mask = IKSTR_INTERN_MIN_SLOTS - 1;
+    p->count = 0;
+    p->flags = flags;
+    if (flags & IKSTR_INTERN_CONCURRENT) ikstr_rwlock_init(&p->lock);
+    return p;
+}
+
+void ikstr_intern_pool_reset(ikstr_intern_pool *p) {
+    if (NULL == p) return;
+    for (size_t i = 0; i <= p->mask; ++i) {
+        ikstr_free(p->slots[i].s);
+        p->slots[i].s = NULL;
+    }
+    p->count = 0;
+}
+
+void ikstr_intern_pool_destroy(ikstr_intern_pool *p) {
+    if (NULL == p) return;
+    ikstr_intern_pool_reset(p);
+    if (p->flags & IKSTR_INTERN_CONCURRENT) ikstr_rwlock_destroy(&p->lock);
+    iks_free_sized(p->slots, sizeof(struct ikstr_intern_slot) * (p->mask + 1));
+    iks_free_sized(p, sizeof(ikstr_intern_pool));
+}
+
+size_t ikstr_intern_pool_count(ikstr_intern_pool *p) {
+    size_t n;
+
+    if (!(p->flags & IKSTR_INTERN_CONCURRENT)) return p->count;
+    ikstr_rwlock_rdlock(&p->lock);
+    n = p->count;
+    ikstr_rwlock_rdunlock(&p->lock);
+    return n;
+}
+
+/*
+ * Returns the slot holding the bytes, or the empty slot where they belong.
+ */
+static struct ikstr_intern_slot *ikstr_intern_probe(const ikstr_intern_pool *p, uint64_t hash,
+                                                    const void *s, size_t len) {
+    size_t i = (size_t)hash & p->mask;
+
+    for (;;) {
+        struct ikstr_intern_slot *slot = &p->slots[i];
+
+        if (NULL == slot->s) return slot;
+        if (slot->hash == hash && ikstr_len(slot->s) == len && (len == 0 || memcmp(slot->s, s, len) == 0))
+            return slot;
+        i = (i + 1) & p->mask;
+    }
+}
+
+/*
+ * Doubles the table. Entries are placed by their stored hash.
+ */
+static int ikstr_intern_grow(ikstr_intern_pool *p) {
+    size_t n = (p->mask + 1) * 2;
+    struct ikstr_intern_slot *old = p->slots, *slots;
+
+    slots = iks_malloc(sizeof(struct ikstr_intern_slot) * n);
+    if (NULL == slots) return 0;
+    memset(slots, 0, sizeof(struct ikstr_intern_slot) * n);
+    for (size_t i = 0; i <= p->mask; ++i) {
+        size_t j;
+
+        if (NULL == old[i].s) continue;
+        for (j = (size_t)old[i].hash & (n - 1); slots[j].s; j = (j + 1) & (n - 1));
+        slots[j] = old[i];
+    }
+    iks_free_sized(old, sizeof(struct ikstr_intern_slot) * (p->mask + 1));
+    p->slots = slots;
+    p->mask = n - 1;
+    return 1;
+}
+
+/*
+ * Lookup and insertion without locking.
+ */
+static ikstr ikstr_intern_insert(ikstr_intern_pool *p, uint64_t hash, const void *s, size_t len) {
+    struct ikstr_intern_slot *slot = ikstr_intern_probe(p, hash, s, len);
+    ikstr c;
+
+    if (slot->s) return slot->s;
+
+    // Keep the load factor below 3/4
+    if ((p->count + 1) * 4 > (p->mask + 1) * 3) {
+        if (!ikstr_intern_grow(p)) return NULL;
+        slot = ikstr_intern_probe(p, hash, s, len);
+    }
+    c = ikstr_new_shared_len(s, len);
+    if (NULL == c) return NULL;
+    ikstr_ext_of(c)->hash = hash; // ikstr_hash on canonical strings is free
+    c[-1] = (char)(c[-1] | IKSTR_FLAG_HASHED);
+    slot->hash = hash;
+    slot->s = c;
+    p->count++;
+    return c;
+}
+
+ikstr ikstr_intern_len(ikstr_intern_pool *p, const void *s, size_t len) {
+    uint64_t hash = ikstr_hash_bytes(s, len, 0);
+    ikstr c;
+
+    if (!(p->flags & IKSTR_INTERN_CONCURRENT)) return ikstr_intern_insert(p, hash, s, len);
+
+    // Read-mostly: existing strings are found under the shared lock
+    ikstr_rwlock_rdlock(&p->lock);
+    c = ikstr_intern_probe(p, hash, s, len)->s;
+    ikstr_rwlock_rdunlock(&p->lock);
+    if (c) return c;
+
+    ikstr_rwlock_wrlock(&p->lock);
+    c = ikstr_intern_insert(p, hash, s, len); // probes again, another thread may have won
+    ikstr_rwlock_wrunlock(&p->lock);
+    return c;
+}
+
+ikstr ikstr_intern(ikstr_intern_pool *p, const char *s) {
+    return ikstr_intern_len(p, s, strlen(s));
+}
+
+ikstr ikstr_intern_find_len(ikstr_intern_pool *p, const void *s, size_t len) {
+    uint64_t hash = ikstr_hash_bytes(s, len, 0);
+    ikstr c;
+
+    if (!(p->flags & IKSTR_INTERN_CONCURRENT)) return ikstr_intern_probe(p, hash, s, len)->s;
+    ikstr_rwlock_rdlock(&p->lock);
+    c = ikstr_intern_probe(p, hash, s, len)->s;
+    ikstr_rwlock_rdunlock(&p->lock);
+    return c;
+}
@@ -0,0 +1,363 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#ifndef IKSTR_IKSTR_INTERNAL_H
+#define IKSTR_IKSTR_INTERNAL_H
+
+#include "ikstr.h"
+#include <limits.h>
+
+/*
+ * Helpers shared between the translation units of the library. Nothing in
+ * here is part of the public API.
+ */
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#   define IKSTR_THREAD_LOCAL __declspec(thread)
+#else
+#   define IKSTR_THREAD_LOCAL _Thread_local
+#endif
+
+/*
+ * For thread-local state touched on hot paths: in a shared library the
+ * initial-exec model saves a __tls_get_addr call per access, but marks the
+ * library STATIC_TLS, which can make dlopen fail once the loader's static
+ * TLS surplus is used up. Opt-in with IKSTR_STATIC_TLS.
+ */
+#if defined(IKSTR_STATIC_TLS) && defined(__GNUC__) && !defined(_WIN32)
+#   define IKSTR_TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#else
+#   define IKSTR_TLS_INITIAL_EXEC
+#endif
+
+/* Index of the lowest set bit, `x` must not be 0. */
+static inline unsigned ikstr_ctz(unsigned x) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_ctz(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward(&i, x);
+    return (unsigned)i;
+#else
+    unsigned n = 0;
+    while (!(x & 1u)) { x >>= 1; ++n; }
+    return n;
+#endif
+}
+
+/* Index of the highest set bit, `x` must not be 0. */
+static inline unsigned ikstr_bsr(unsigned x) {
+#if defined(__GNUC__)
+    return 31u - (unsigned)__builtin_clz(x);
+#elif defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse(&i, x);
+    return (unsigned)i;
+#else
+    unsigned n = 0;
+    while (x >>= 1) ++n;
+    return n;
+#endif
+}
+
+static inline int ikstr_hdr_size(unsigned char type) {
+    switch (type & IKSTR_TYPE_MASK) {
+        case IKSTR_8:
+            return sizeof(struct ikstrhdr8);
+        case IKSTR_16:
+            return sizeof(struct ikstrhdr16);
+        case IKSTR_32:
+            return sizeof(struct ikstrhdr32);
+        case IKSTR_64:
+            return sizeof(struct ikstrhdr64);
+        default:
+            return 0 ;
+    }
+}
+
+static inline char ikstr_req_type(size_t len) {
+    if (len < 256) return IKSTR_8;
+    if (len < 65536) return IKSTR_16;
+#if(LONG_MAX == LLONG_MAX)
+    if (len < 4294967296) return IKSTR_32;
+    return IKSTR_64;
+#else
+    return IKSTR_32;
+#endif
+}
+
+/*
+ * Prefix stored in front of the header of shared strings
+ * (IKSTR_FLAG_SHARED). The allocation starts at the prefix.
+ */
+struct ikstr_ext {
+    size_t refs;
+    uint64_t hash;  // valid if IKSTR_FLAG_HASHED is set
+};
+
+static inline struct ikstr_ext *ikstr_ext_of(ikstr s) {
+    return (struct ikstr_ext *)(s - ikstr_hdr_size(s[-1]) - sizeof(struct ikstr_ext));
+}
+
+/*
+ * Bytes between the start of the allocation and `s`.
+ */
+static inline size_t ikstr_prefix_size(ikstr s) {
+    size_t n = ikstr_hdr_size(s[-1]);
+    if (s[-1] & IKSTR_FLAG_SHARED) n += sizeof(struct ikstr_ext);
+    return n;
+}
+
+/*
+ * Reference count updates. They are atomic so shared strings can be passed
+ * between threads; taking a reference only needs to be ordered with respect
+ * to the release that may free the string.
+ */
+#if defined(__GNUC__)
+static inline void ikstr_ref_inc(size_t *r) {
+    __atomic_fetch_add(r, 1, __ATOMIC_RELAXED);
+}
+
+static inline size_t ikstr_ref_dec(size_t *r) {
+    return __atomic_sub_fetch(r, 1, __ATOMIC_ACQ_REL);
+}
+
+static inline size_t ikstr_ref_load(const size_t *r) {
+    return __atomic_load_n(r, __ATOMIC_ACQUIRE);
+}
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#   if defined(_WIN64)
+static inline void ikstr_ref_inc(size_t *r) {
+    _InterlockedIncrement64((volatile __int64 *)r);
+}
+
+static inline size_t ikstr_ref_dec(size_t *r) {
+    return (size_t)_InterlockedDecrement64((volatile __int64 *)r);
+}
+#   else
+static inline void ikstr_ref_inc(size_t *r) {
+    _InterlockedIncrement((volatile long *)r);
+}
+
+static inline size_t ikstr_ref_dec(size_t *r) {
+    return (size_t)_InterlockedDecrement((volatile long *)r);
+}
+#   endif
+
+static inline size_t ikstr_ref_load(const size_t *r) {
+    return *(const volatile size_t *)r;
+}
+#else
+static inline void ikstr_ref_inc(size_t *r) {
+    ++*r;
+}
+
+static inline size_t ikstr_ref_dec(size_t *r) {
+    return --*r;
+}
+
+static inline size_t ikstr_ref_load(const size_t *r) {
+    return *r;
+}
+#endif
+
+/*
+ * Counters with a single writer (the owning thread) that other threads may
+ * read at any time: a relaxed store is enough, without a locked instruction.
+ */
+#if defined(__GNUC__)
+static inline void ikstr_relaxed_add(size_t *c, size_t n) {
+    __atomic_store_n(c, *c + n, __ATOMIC_RELAXED);
+}
+
+static inline size_t ikstr_relaxed_load(const size_t *c) {
+    return __atomic_load_n(c, __ATOMIC_RELAXED);
+}
+#else
+static inline void ikstr_relaxed_add(size_t *c, size_t n) {
+    *(volatile size_t *)c = *c + n;
+}
+
+static inline size_t ikstr_relaxed_load(const size_t *c) {
+    return *(const volatile size_t *)c;
+}
+#endif
+
+/*
+ * Statistics hooks, compiled in with IKSTR_STATS (see ikstr_stats.h). When
+ * it is not defined they expand to nothing and their arguments are not
+ * evaluated.
+ */
+#ifdef IKSTR_STATS
+#include "ikstr_stats.h"
+
+struct ikstr_stats_local {
+    ikstr_stats st;                         // written by the owning thread only
+    struct ikstr_stats_local *prev, *next;  // registry of live threads
+    int state;                              // 0 until registered
+};
+
+extern IKSTR_THREAD_LOCAL IKSTR_TLS_INITIAL_EXEC struct ikstr_stats_local ikstr_stats_tls;
+
+void ikstr_stats_register(struct ikstr_stats_local *l);
+
+static inline ikstr_stats *ikstr_stats_mine(void) {
+    struct ikstr_stats_local *l = &ikstr_stats_tls;
+
+    if (0 == l->state) ikstr_stats_register(l);
+    return &l->st;
+}
+
+#   define IKSTR_STAT_ADD(field, n) ikstr_relaxed_add(&ikstr_stats_mine()->field, (size_t)(n))
+#   define IKSTR_STAT_CALL(call) IKSTR_STAT_ADD(calls[call], 1)
+#else
+#   define IKSTR_STAT_ADD(field, n) ((void)0)
+#   define IKSTR_STAT_CALL(call) ((void)0)
+#endif
+
+/*
+ * Creates a shared string holding a copy of `len` bytes, with a reference
+ * count of 1 and no spare capacity.
+ */
+ikstr ikstr_new_shared_len(const void *init, size_t len);
+
+/*
+ * Copy-on-write slow path, see ikstr_unshare.
+ */
+ikstr ikstr_unshare_slow(ikstr s, size_t addlen);
+
+/*
+ * Called by every function that modifies a string before it touches the
+ * content or the header. A shared string that has other references, or a
+ * mapped file, is replaced by a private copy with room for `addlen` more
+ * bytes (the caller's reference to the original is dropped); a cached hash
+ * is invalidated; anything else is returned as is. Returns NULL if the copy
+ * cannot be allocated, leaving `s` untouched.
+ */
+static inline ikstr ikstr_unshare(ikstr s, size_t addlen) {
+    if (s[-1] & (IKSTR_FLAG_SHARED | IKSTR_FLAG_MAPPED)) return ikstr_unshare_slow(s, addlen);
+    return s;
+}
+
+/*
+ * Unmaps a string created by ikstr_map_file.
+ */
+void ikstr_unmap(ikstr s);
+
+/*
+ * The default allocator, wrapping malloc/realloc/free.
+ */
+extern const struct ikstr_allocator ikstr_libc_allocator;
+
+/*
+ * Largest length or capacity a header of the given type can store.
+ */
+static inline size_t ikstr_type_max(unsigned char type) {
+    switch (type & IKSTR_TYPE_MASK) {
+        case IKSTR_8:
+            return UINT8_MAX;
+        case IKSTR_16:
+            return UINT16_MAX;
+        case IKSTR_32:
+            return UINT32_MAX;
+        default:
+            return SIZE_MAX;
+    }
+}
+
+/*
+ * Writes a header of the given type in front of `s` and stores the flags
+ * byte. The caller is responsible for the payload and the trailing '\0'.
+ */
+static inline void ikstr_init_hdr(ikstr s, unsigned char flags, size_t len, size_t cap) {
+    switch (flags & IKSTR_TYPE_MASK) {
+        case IKSTR_8: {
+            IKSTR_HDR_VAR(8, s);
+            shdr->len = len;
+            shdr->cap = cap;
+            break;
+        }
+        case IKSTR_16: {
+            IKSTR_HDR_VAR(16, s);
+            shdr->len = len;
+            shdr->cap = cap;
+            break;
+        }
+        case IKSTR_32: {
+            IKSTR_HDR_VAR(32, s);
+            shdr->len = len;
+            shdr->cap = cap;
+            break;
+        }
+        case IKSTR_64: {
+            IKSTR_HDR_VAR(64, s);
+            shdr->len = len;
+            shdr->cap = cap;
+            break;
+        }
+        default:
+            break;
+    }
+    s[-1] = (char)flags;
+}
+
+/*
+ * Returns the capacity to grow a string of capacity `cap` to so that it can
+ * hold `req_len` bytes, according to the policy set with ikstr_set_growth.
+ */
+size_t ikstr_grow_len(size_t cap, size_t req_len);
+
+/*
+ * Needles up to this length are searched with the SIMD first/last byte
+ * filter; longer ones with the linear-time Two-Way algorithm.
+ */
+#define IKSTR_SHORT_NEEDLE 32
+
+/*
+ * Returns a pointer to the first occurrence of the `nl` bytes at `n` within
+ * the `hl` bytes at `h`, or NULL. `nl` must be greater than 0.
+ */
+const char *ikstr_memmem(const char *h, size_t hl, const char *n, size_t nl);
+
+/*
+ * Like ikstr_memmem, but returns the last occurrence.
+ */
+const char *ikstr_memrmem(const char *h, size_t hl, const char *n, size_t nl);
+
+/*
+ * Returns a pointer to the last occurrence of `c` within the `hl` bytes at
+ * `h`, or NULL.
+ */
+const char *ikstr_memrchr(const char *h, size_t hl, int c);
+
+/*
+ * Returns the length of the longest prefix of the `n` bytes at `p` made only
+ * of bytes in `cs`.
+ */
+size_t ikstr_span(const char *p, size_t n, const ikstr_charset *cs);
+
+/*
+ * Returns the length of the longest suffix of the `n` bytes at `p` made only
+ * of bytes in `cs`.
+ */
+size_t ikstr_rspan(const char *p, size_t n, const ikstr_charset *cs);
+
+/*
+ * 64-bit hash of `len` bytes (wyhash).
+ */
+uint64_t ikstr_hash_bytes(const void *key, size_t len, uint64_t seed);
+
+/*
+ * Number of decimal digits of `v`.
+ */
+unsigned ikstr_u64_digits(uint64_t v);
+
+/*
+ * Writes the decimal digits of `v` ending right before `end`, two at a time.
+ */
+void ikstr_u64_write(char *end, uint64_t v);
+
+#endif //IKSTR_IKSTR_INTERNAL_H
@@ -0,0 +1,311 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_map.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#   define IKSTR_HAVE_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+#define IKSTR_MAP_GROUP 16          // control bytes examined per probe step
+#define IKSTR_MAP_MIN_SLOTS 16
+#define IKSTR_CTRL_EMPTY   ((signed char)-128)
+#define IKSTR_CTRL_DELETED ((signed char)-2)
+// Full slots hold the low 7 bits of the hash (0..127), so the sign bit alone
+// tells free slots from full ones.
+
+struct ikstr_map_slot {
+    uint64_t hash;
+    ikstr key;
+    void *value;
+};
+
+struct ikstr_map {
+    signed char *ctrl;              // slots + IKSTR_MAP_GROUP bytes, the tail mirrors the first group
+    struct ikstr_map_slot *slots;
+    size_t mask;                    // number of slots - 1, a power of two minus one
+    size_t count;
+    size_t growth_left;             // empty slots that may still be filled before a rehash
+};
+
+/*
+ * Bit i of the results is set if control byte g[i] is respectively h2, empty,
+ * or free (empty or deleted).
+ */
+static inline unsigned ikstr_map_match(const signed char *g, signed char h2) {
+#ifdef IKSTR_HAVE_SSE2
+    __m128i c = _mm_loadu_si128((const __m128i *)g);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(c, _mm_set1_epi8(h2)));
+#else
+    unsigned m = 0;
+    for (unsigned i = 0; i < IKSTR_MAP_GROUP; ++i) m |= (unsigned)(g[i] == h2) << i;
+    return m;
+#endif
+}
+
+static inline unsigned ikstr_map_match_empty(const signed char *g) {
+    return ikstr_map_match(g, IKSTR_CTRL_EMPTY);
+}
+
+static inline unsigned ikstr_map_match_free(const signed char *g) {
+#ifdef IKSTR_HAVE_SSE2
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+#else
+    unsigned m = 0;
+    for (unsigned i = 0; i < IKSTR_MAP_GROUP; ++i) m |= (unsigned)(g[i] < 0) << i;
+    return m;
+#endif
+}
+
+/*
+ * Writes a control byte and its mirror, so that a group can be loaded from
+ * any slot without wrapping around.
+ */
+static inline void ikstr_map_set_ctrl(ikstr_map *m, size_t i, signed char c) {
+    m->ctrl[i] = c;
+    m->ctrl[((i - IKSTR_MAP_GROUP) & m->mask) + IKSTR_MAP_GROUP] = c;
+}
+
+static inline size_t ikstr_map_max_load(size_t slots) {
+    return slots - slots / 8;
+}
+
+/*
+ * Allocates empty arrays for `n` slots and moves the entries of `m` into
+ * them, placed by their stored hash. Returns 0 if an allocation fails,
+ * leaving `m` unchanged.
+ */
+static int ikstr_map_resize(ikstr_map *m, size_t n) {
+    signed char *ctrl = iks_malloc(n + IKSTR_MAP_GROUP);
+    struct ikstr_map_slot *slots = iks_malloc(sizeof(struct ikstr_map_slot) * n);
+    size_t old_n = m->slots ? m->mask + 1 : 0;
+
+    if (NULL == ctrl || NULL == slots) {
+        iks_free_sized(ctrl, n + IKSTR_MAP_GROUP);
+        iks_free_sized(slots, sizeof(struct ikstr_map_slot) * n);
+        return 0;
+    }
+    memset(ctrl, IKSTR_CTRL_EMPTY, n + IKSTR_MAP_GROUP);
+
+    for (size_t i = 0; i < old_n; ++i) {
+        uint64_t hash = m->slots[i].hash;
+        size_t pos = (size_t)(hash >> 7) & (n - 1), step = 0, j;
+        unsigned bits;
+
+        if (m->ctrl[i] < 0) continue;
+        while (0 == (bits = ikstr_map_match_empty(ctrl + pos))) {
+            step += IKSTR_MAP_GROUP;
+            pos = (pos + step) & (n - 1);
+        }
+        j = (pos + ikstr_ctz(bits)) & (n - 1);
+        ctrl[j] = (signed char)(hash & 0x7f);
+        ctrl[((j - IKSTR_MAP_GROUP) & (n - 1)) + IKSTR_MAP_GROUP] = ctrl[j];
+        slots[j] = m->slots[i];
+    }
+    if (old_n) {
+        iks_free_sized(m->ctrl, old_n + IKSTR_MAP_GROUP);
+        iks_free_sized(m->slots, sizeof(struct ikstr_map_slot) * old_n);
+    }
+    m->ctrl = ctrl;
+    m->slots = slots;
+    m->mask = n - 1;
+    m->growth_left = ikstr_map_max_load(n) - m->count;
+    return 1;
+}
+
+ikstr_map *ikstr_map_create(size_t capacity) {
+    ikstr_map *m = iks_malloc(sizeof(ikstr_map));
+    size_t n = IKSTR_MAP_MIN_SLOTS;
+
+    if (NULL == m) return NULL;
+    while (ikstr_map_max_load(n) < capacity) {
+        if (n > SIZE_MAX / 2 / sizeof(struct ikstr_map_slot)) {
+            iks_free_sized(m, sizeof(ikstr_map));
+            return NULL;
+        }
+        n *= 2;
+    }
+    memset(m, 0, sizeof(ikstr_map));
+    if (!ikstr_map_resize(m, n)) {
+        iks_free_sized(m, sizeof(ikstr_map));
+        return NULL;
+    }
+    return m;
+}
+
+void ikstr_map_clear(ikstr_map *m) {
+    if (NULL == m) return;
+    for (size_t i = 0; i <= m->mask; ++i) {
+        if (m->ctrl[i] >= 0) ikstr_free(m->slots[i].key);
+    }
+    memset(m->ctrl, IKSTR_CTRL_EMPTY, m->mask + 1 + IKSTR_MAP_GROUP);
+    m->count = 0;
+    m->growth_left = ikstr_map_max_load(m->mask + 1);
+}
+
+void ikstr_map_destroy(ikstr_map *m) {
+    if (NULL == m) return;
+    ikstr_map_clear(m);
+    iks_free_sized(m->ctrl, m->mask + 1 + IKSTR_MAP_GROUP);
+    iks_free_sized(m->slots, sizeof(struct ikstr_map_slot) * (m->mask + 1));
+    iks_free_sized(m, sizeof(ikstr_map));
+}
+
+size_t ikstr_map_count(const ikstr_map *m) {
+    return m->count;
+}
+
+/*
+ * Returns the slot holding the key, or NULL. Candidates are the slots whose
+ * control byte matches the low 7 bits of the hash; the stored hash and the
+ * key length are compared before the bytes.
+ */
+static struct ikstr_map_slot *ikstr_map_lookup(const ikstr_map *m, uint64_t hash,
+                                               const void *key, size_t len) {
+    signed char h2 = (signed char)(hash & 0x7f);
+    size_t pos = (size_t)(hash >> 7) & m->mask, step = 0;
+
+#if defined(__GNUC__)
+    // The first candidate is usually the first slot of the group: fetch it
+    // while the control bytes are loaded instead of after
+    __builtin_prefetch(&m->slots[pos]);
+#endif
+    for (;;) {
+        const signed char *g = m->ctrl + pos;
+        unsigned bits = ikstr_map_match(g, h2);
+
+        while (bits) {
+            struct ikstr_map_slot *slot = &m->slots[(pos + ikstr_ctz(bits)) & m->mask];
+
+            if (slot->hash == hash && ikstr_len(slot->key) == len
+                && (len == 0 || memcmp(slot->key, key, len) == 0))
+                return slot;
+            bits &= bits - 1;
+        }
+        // An empty slot ends every probe sequence that could contain the key
+        if (ikstr_map_match_empty(g)) return NULL;
+        step += IKSTR_MAP_GROUP;
+        pos = (pos + step) & m->mask;
+    }
+}
+
+/*
+ * Returns the first free slot on the probe sequence of `hash`.
+ */
+static size_t ikstr_map_find_free(const ikstr_map *m, uint64_t hash) {
+    size_t pos = (size_t)(hash >> 7) & m->mask, step = 0;
+    unsigned bits;
+
+    while (0 == (bits = ikstr_map_match_free(m->ctrl + pos))) {
+        step += IKSTR_MAP_GROUP;
+        pos = (pos + step) & m->mask;
+    }
+    return (pos + ikstr_ctz(bits)) & m->mask;
+}
+
+/*
+ * Insertion shared by the put functions. `src` is the caller's key if it is
+ * an `ikstr`, NULL otherwise.
+ */
+static int ikstr_map_insert(ikstr_map *m, uint64_t hash, const void *key, size_t len,
+                            ikstr src, void *value) {
+    struct ikstr_map_slot *slot = ikstr_map_lookup(m, hash, key, len);
+    size_t i;
+    ikstr k;
+
+    if (slot) {
+        slot->value = value;
+        return 0;
+    }
+
+    if (src && (src[-1] & IKSTR_FLAG_SHARED)) k = ikstr_retain(src);
+    else k = ikstr_new_len(key, len);
+    if (NULL == k) return -1;
+
+    i = ikstr_map_find_free(m, hash);
+    if (m->growth_left == 0 && m->ctrl[i] == IKSTR_CTRL_EMPTY) {
+        size_t n = m->mask + 1;
+
+        // Double when more than 7/16 full, otherwise only drop the tombstones
+        if ((m->count + 1) * 16 > n * 7) {
+            if (n > SIZE_MAX / 2 / sizeof(struct ikstr_map_slot)) {
+                ikstr_free(k);
+                return -1;
+            }
+            n *= 2;
+        }
+        if (!ikstr_map_resize(m, n)) {
+            ikstr_free(k);
+            return -1;
+        }
+        i = ikstr_map_find_free(m, hash);
+    }
+
+    if (m->ctrl[i] == IKSTR_CTRL_EMPTY) m->growth_left--;
+    ikstr_map_set_ctrl(m, i, (signed char)(hash & 0x7f));
+    m->slots[i].hash = hash;
+    m->slots[i].key = k;
+    m->slots[i].value = value;
+    m->count++;
+    return 0;
+}
+
+int ikstr_map_put_len(ikstr_map *m, const void *key, size_t len, void *value) {
+    return ikstr_map_insert(m, ikstr_hash_bytes(key, len, 0), key, len, NULL, value);
+}
+
+int ikstr_map_put(ikstr_map *m, ikstr key, void *value) {
+    return ikstr_map_insert(m, ikstr_hash(key), key, ikstr_len(key), key, value);
+}
+
+void **ikstr_map_find_len(const ikstr_map *m, const void *key, size_t len) {
+    struct ikstr_map_slot *slot = ikstr_map_lookup(m, ikstr_hash_bytes(key, len, 0), key, len);
+    return slot ? &slot->value : NULL;
+}
+
+void **ikstr_map_find(const ikstr_map *m, ikstr key) {
+    struct ikstr_map_slot *slot = ikstr_map_lookup(m, ikstr_hash(key), key, ikstr_len(key));
+    return slot ? &slot->value : NULL;
+}
+
+int ikstr_map_remove_len(ikstr_map *m, const void *key, size_t len, void **value) {
+    struct ikstr_map_slot *slot = ikstr_map_lookup(m, ikstr_hash_bytes(key, len, 0), key, len);
+    size_t i;
+    unsigned before, after;
+
+    if (NULL == slot) return 0;
+    i = (size_t)(slot - m->slots);
+    if (value) *value = slot->value;
+    ikstr_free(slot->key);
+    m->count--;
+
+    // If every group window covering the slot has seen an empty slot, no
+    // probe sequence ever passed it full, and it can become empty again
+    before = ikstr_map_match_empty(m->ctrl + ((i - IKSTR_MAP_GROUP) & m->mask));
+    after = ikstr_map_match_empty(m->ctrl + i);
+    if (before && after
+        && ikstr_ctz(after) + (IKSTR_MAP_GROUP - 1 - ikstr_bsr(before)) < IKSTR_MAP_GROUP) {
+        ikstr_map_set_ctrl(m, i, IKSTR_CTRL_EMPTY);
+        m->growth_left++;
+    } else {
+        ikstr_map_set_ctrl(m, i, IKSTR_CTRL_DELETED);
+    }
+    return 1;
+}
+
+int ikstr_map_next(const ikstr_map *m, size_t *pos, ikstr *key, void **value) {
+    for (size_t i = *pos; i <= m->mask; ++i) {
+        if (m->ctrl[i] < 0) continue;
+        if (key) *key = m->slots[i].key;
+        if (value) *value = m->slots[i].value;
+        *pos = i + 1;
+        return 1;
+    }
+    *pos = m->mask + 1;
+    return 0;
+}
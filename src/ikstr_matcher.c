@@ -0,0 +1,215 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_matcher.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <stdint.h>
+#include <string.h>
+
+#define IKSTR_AC_NONE UINT32_MAX
+#define IKSTR_AC_OUT  0x80000000u // transition leads to a state with outputs
+
+struct ikstr_matcher {
+    size_t states;
+    size_t max_states;  // rows allocated in trans
+    size_t classes;
+    size_t patterns;
+    size_t outputs;
+    uint16_t cls[256];  // byte -> class, 0 for bytes that occur in no pattern
+    uint32_t *trans;    // states * classes, complete DFA; entries hold the target row
+                        // offset (state * classes), tagged with IKSTR_AC_OUT
+    uint32_t *out_off;  // states + 1, outputs of state i are out[out_off[i] .. out_off[i + 1])
+    uint32_t *out;      // pattern ids, longest first per state
+    size_t *pat_len;    // patterns
+};
+
+void ikstr_matcher_free(ikstr_matcher *m) {
+    if (NULL == m) return;
+    iks_free_sized(m->trans, sizeof(uint32_t) * m->max_states * m->classes);
+    iks_free_sized(m->out_off, sizeof(uint32_t) * (m->states + 1));
+    iks_free_sized(m->out, sizeof(uint32_t) * m->outputs);
+    iks_free_sized(m->pat_len, sizeof(size_t) * (m->patterns ? m->patterns : 1));
+    iks_free_sized(m, sizeof(ikstr_matcher));
+}
+
+ikstr_matcher *ikstr_matcher_compile(const ikstr *needles, size_t count) {
+    ikstr_matcher *m;
+    size_t max_states = 1, states = 1, i, head, tail;
+    uint32_t *fail = NULL, *own = NULL, *own_next = NULL, *queue = NULL, *cnt = NULL;
+
+    if (count >= IKSTR_AC_NONE) return NULL;
+    m = iks_malloc(sizeof(ikstr_matcher));
+    if (NULL == m) return NULL;
+    memset(m, 0, sizeof(*m));
+    m->patterns = count;
+    m->classes = 1;
+
+    // Byte classes: one per distinct pattern byte plus a shared "other" class
+    for (i = 0; i < count; ++i) {
+        size_t len = ikstr_len(needles[i]);
+        max_states += len;
+        for (size_t j = 0; j < len; ++j) {
+            unsigned char c = (unsigned char)needles[i][j];
+            if (m->cls[c] == 0) m->cls[c] = (uint16_t)m->classes++;
+        }
+    }
+    if (max_states * m->classes >= IKSTR_AC_OUT) goto cleanup;
+
+    m->max_states = max_states;
+    m->trans = iks_malloc(sizeof(uint32_t) * max_states * m->classes);
+    m->pat_len = iks_malloc(sizeof(size_t) * (count ? count : 1));
+    fail = iks_malloc(sizeof(uint32_t) * max_states);
+    own = iks_malloc(sizeof(uint32_t) * max_states);
+    own_next = iks_malloc(sizeof(uint32_t) * (count ? count : 1));
+    queue = iks_malloc(sizeof(uint32_t) * max_states);
+    cnt = iks_malloc(sizeof(uint32_t) * max_states);
+    if (!m->trans || !m->pat_len || !fail || !own || !own_next || !queue || !cnt) goto cleanup;
+    memset(m->trans, 0xff, sizeof(uint32_t) * max_states * m->classes);
+    memset(own, 0xff, sizeof(uint32_t) * max_states);
+
+    // Trie
+    for (i = 0; i < count; ++i) {
+        size_t len = ikstr_len(needles[i]), st = 0;
+
+        m->pat_len[i] = len;
+        if (len == 0) continue;
+        for (size_t j = 0; j < len; ++j) {
+            uint32_t *t = &m->trans[st * m->classes + m->cls[(unsigned char)needles[i][j]]];
+            if (*t == IKSTR_AC_NONE) *t = (uint32_t)states++;
+            st = *t;
+        }
+        own_next[i] = own[st];
+        own[st] = (uint32_t)i;
+    }
+
+    // Breadth-first: failure links, missing transitions and output counts
+    fail[0] = 0;
+    cnt[0] = 0;
+    head = tail = 0;
+    for (size_t c = 0; c < m->classes; ++c) {
+        uint32_t *t = &m->trans[c];
+        if (*t == IKSTR_AC_NONE) {
+            *t = 0;
+        } else {
+            fail[*t] = 0;
+            queue[tail++] = *t;
+        }
+    }
+    while (head < tail) {
+        uint32_t u = queue[head++], n = 0;
+
+        for (uint32_t p = own[u]; p != IKSTR_AC_NONE; p = own_next[p]) ++n;
+        cnt[u] = n + cnt[fail[u]];
+        for (size_t c = 0; c < m->classes; ++c) {
+            uint32_t *t = &m->trans[u * m->classes + c];
+            uint32_t f = m->trans[fail[u] * m->classes + c];
+            if (*t == IKSTR_AC_NONE) {
+                *t = f;
+            } else {
+                fail[*t] = f;
+                queue[tail++] = *t;
+            }
+        }
+    }
+
+    // Flatten the outputs: own patterns first, then those of the fail state
+    m->states = states;
+    m->out_off = iks_malloc(sizeof(uint32_t) * (states + 1));
+    if (NULL == m->out_off) goto cleanup;
+    m->out_off[0] = 0;
+    for (i = 0; i < states; ++i) m->out_off[i + 1] = m->out_off[i] + cnt[i];
+    m->outputs = m->out_off[states] ? m->out_off[states] : 1;
+    m->out = iks_malloc(sizeof(uint32_t) * m->outputs);
+    if (NULL == m->out) goto cleanup;
+    for (head = 0; head < tail; ++head) {
+        uint32_t u = queue[head], *o = m->out + m->out_off[u];
+
+        for (uint32_t p = own[u]; p != IKSTR_AC_NONE; p = own_next[p]) *o++ = p;
+        memcpy(o, m->out + m->out_off[fail[u]], sizeof(uint32_t) * cnt[fail[u]]);
+    }
+
+    // Turn state ids into row offsets so scanning needs no multiplication
+    for (i = 0; i < states * m->classes; ++i) {
+        uint32_t v = m->trans[i];
+        m->trans[i] = (uint32_t)(v * m->classes) | (cnt[v] ? IKSTR_AC_OUT : 0);
+    }
+
+    iks_free_sized(fail, sizeof(uint32_t) * max_states);
+    iks_free_sized(own, sizeof(uint32_t) * max_states);
+    iks_free_sized(own_next, sizeof(uint32_t) * (count ? count : 1));
+    iks_free_sized(queue, sizeof(uint32_t) * max_states);
+    iks_free_sized(cnt, sizeof(uint32_t) * max_states);
+    return m;
+
+    cleanup:
+    {
+        iks_free_sized(fail, sizeof(uint32_t) * max_states);
+        iks_free_sized(own, sizeof(uint32_t) * max_states);
+        iks_free_sized(own_next, sizeof(uint32_t) * (count ? count : 1));
+        iks_free_sized(queue, sizeof(uint32_t) * max_states);
+        iks_free_sized(cnt, sizeof(uint32_t) * max_states);
+        ikstr_matcher_free(m);
+        return NULL;
+    }
+}
+
+size_t ikstr_matcher_states(const ikstr_matcher *m) {
+    return m->states;
+}
+
+size_t ikstr_matcher_scan_len(const ikstr_matcher *m, const char *s, size_t len,
+                              ikstr_match_cb cb, void *ctx) {
+    const uint32_t *trans = m->trans;
+    const uint16_t *cls = m->cls;
+    size_t found = 0;
+    uint32_t row = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        uint32_t t = trans[row + cls[(unsigned char)s[i]]];
+        row = t & ~IKSTR_AC_OUT;
+        if (t & IKSTR_AC_OUT) {
+            size_t st = row / m->classes;
+            for (uint32_t o = m->out_off[st]; o < m->out_off[st + 1]; ++o) {
+                uint32_t p = m->out[o];
+                ++found;
+                if (cb(ctx, p, i + 1 - m->pat_len[p])) return found;
+            }
+        }
+    }
+    return found;
+}
+
+size_t ikstr_matcher_scan(const ikstr_matcher *m, ikstr s, ikstr_match_cb cb, void *ctx) {
+    return ikstr_matcher_scan_len(m, s, ikstr_len(s), cb, ctx);
+}
+
+void ikstr_match_iter_init(ikstr_match_iter *it, const ikstr_matcher *m, const char *s, size_t len) {
+    it->m = m;
+    it->s = s;
+    it->len = len;
+    it->pos = 0;
+    it->state = 0;
+    it->out = it->out_end = 0;
+}
+
+int ikstr_match_iter_next(ikstr_match_iter *it, size_t *pattern_id, size_t *offset) {
+    const ikstr_matcher *m = it->m;
+
+    while (it->out == it->out_end) {
+        uint32_t t;
+
+        if (it->pos == it->len) return 0;
+        t = m->trans[it->state + m->cls[(unsigned char)it->s[it->pos++]]];
+        it->state = t & ~IKSTR_AC_OUT;
+        if (t & IKSTR_AC_OUT) {
+            size_t st = it->state / m->classes;
+            it->out = m->out_off[st];
+            it->out_end = m->out_off[st + 1];
+        }
+    }
+    *pattern_id = m->out[it->out++];
+    *offset = it->pos - m->pat_len[*pattern_id];
+    return 1;
+}
@@ -0,0 +1,427 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_rope.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+
+#define IKSTR_ROPE_SMALL 256    // insertions up to this size may extend a chunk in place
+#define IKSTR_ROPE_CHUNK 4096   // as long as the chunk stays within this size
+
+/*
+ * A treap node: ordered by position, heap-ordered by `prio`. The node holds
+ * the piece data[off .. off + len) of a shared chunk.
+ */
+struct ikstr_rope_node {
+    struct ikstr_rope_node *left;
+    struct ikstr_rope_node *right;
+    size_t total;   // bytes in the subtree
+    size_t chunks;  // nodes in the subtree
+    size_t refs;    // parents and ropes pointing at the node
+    ikstr data;
+    size_t off;
+    size_t len;
+    uint32_t prio;
+};
+
+struct ikstr_rope {
+    struct ikstr_rope_node *root;
+    struct ikstr_rope_node *spare;  // preallocated nodes, linked through `left`
+    size_t nspare;
+    uint32_t seed;
+};
+
+typedef struct ikstr_rope_node ikstr_rope_node;
+
+static inline size_t ikstr_rope_total(const ikstr_rope_node *t) {
+    return t ? t->total : 0;
+}
+
+static inline void ikstr_rope_update(ikstr_rope_node *t) {
+    t->total = ikstr_rope_total(t->left) + t->len + ikstr_rope_total(t->right);
+    t->chunks = (t->left ? t->left->chunks : 0) + 1 + (t->right ? t->right->chunks : 0);
+}
+
+static uint32_t ikstr_rope_prio(ikstr_rope *r) {
+    uint32_t x = r->seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return r->seed = x;
+}
+
+/*
+ * Makes sure `n` nodes can be taken without allocating. Edits reserve the
+ * nodes they may need first, so a failed allocation leaves the tree intact.
+ */
+static int ikstr_rope_reserve(ikstr_rope *r, size_t n) {
+    while (r->nspare < n) {
+        ikstr_rope_node *t = iks_malloc(sizeof(ikstr_rope_node));
+        if (NULL == t) return 0;
+        t->left = r->spare;
+        r->spare = t;
+        r->nspare++;
+    }
+    return 1;
+}
+
+static ikstr_rope_node *ikstr_rope_take(ikstr_rope *r) {
+    ikstr_rope_node *t = r->spare;
+    r->spare = t->left;
+    r->nspare--;
+    return t;
+}
+
+static void ikstr_rope_release(ikstr_rope_node *t) {
+    if (NULL == t || ikstr_ref_dec(&t->refs) != 0) return;
+    ikstr_rope_release(t->left);
+    ikstr_rope_release(t->right);
+    ikstr_free(t->data);
+    iks_free_sized(t, sizeof(ikstr_rope_node));
+}
+
+/*
+ * Returns a node that may be modified: `t` itself if nothing else points at
+ * it, otherwise a copy (the caller's reference to `t` is dropped).
+ */
+static ikstr_rope_node *ikstr_rope_unique(ikstr_rope *r, ikstr_rope_node *t) {
+    ikstr_rope_node *c;
+
+    if (ikstr_ref_load(&t->refs) == 1) return t;
+    c = ikstr_rope_take(r);
+    *c = *t;
+    c->refs = 1;
+    if (c->left) ikstr_ref_inc(&c->left->refs);
+    if (c->right) ikstr_ref_inc(&c->right->refs);
+    ikstr_retain(c->data);
+    ikstr_rope_release(t);
+    return c;
+}
+
+/*
+ * Upper bound of the nodes `ikstr_rope_split` takes: one copy per node on
+ * the path to `pos`, plus one if `pos` falls inside a piece.
+ */
+static size_t ikstr_rope_path(const ikstr_rope_node *t, size_t pos) {
+    size_t n = 1;
+
+    while (t) {
+        size_t lsz = ikstr_rope_total(t->left);
+
+        ++n;
+        if (pos <= lsz) {
+            t = t->left;
+        } else if (pos >= lsz + t->len) {
+            pos -= lsz + t->len;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    return n;
+}
+
+/*
+ * Splits `t` into the first `pos` bytes (`*l`) and the rest (`*g`). Only the
+ * nodes on the path to `pos` are touched, and copied if they are shared; a
+ * piece containing `pos` is cut into two nodes referencing the same chunk.
+ */
+static void ikstr_rope_split(ikstr_rope *r, ikstr_rope_node *t, size_t pos,
+                             ikstr_rope_node **l, ikstr_rope_node **g) {
+    size_t lsz;
+
+    if (NULL == t) {
+        *l = *g = NULL;
+        return;
+    }
+    t = ikstr_rope_unique(r, t);
+    lsz = ikstr_rope_total(t->left);
+    if (pos <= lsz) {
+        ikstr_rope_split(r, t->left, pos, l, &t->left);
+        ikstr_rope_update(t);
+        *g = t;
+    } else if (pos >= lsz + t->len) {
+        ikstr_rope_split(r, t->right, pos - lsz - t->len, &t->right, g);
+        ikstr_rope_update(t);
+        *l = t;
+    } else {
+        ikstr_rope_node *b = ikstr_rope_take(r);
+        size_t k = pos - lsz;
+
+        b->left = NULL;
+        b->right = t->right;
+        b->refs = 1;
+        b->data = ikstr_retain(t->data);
+        b->off = t->off + k;
+        b->len = t->len - k;
+        b->prio = t->prio;
+        ikstr_rope_update(b);
+        t->right = NULL;
+        t->len = k;
+        ikstr_rope_update(t);
+        *l = t;
+        *g = b;
+    }
+}
+
+/*
+ * Joins two trees, all of `a` before all of `b`. Only walks the right spine
+ * of `a` and the left spine of `b`, which are the nodes a split just made
+ * unique, so it never allocates.
+ */
+static ikstr_rope_node *ikstr_rope_merge(ikstr_rope_node *a, ikstr_rope_node *b) {
+    if (NULL == a) return b;
+    if (NULL == b) return a;
+    if (a->prio > b->prio) {
+        a->right = ikstr_rope_merge(a->right, b);
+        ikstr_rope_update(a);
+        return a;
+    }
+    b->left = ikstr_rope_merge(a, b->left);
+    ikstr_rope_update(b);
+    return b;
+}
+
+ikstr_rope *ikstr_rope_new(void) {
+    ikstr_rope *r = iks_malloc(sizeof(ikstr_rope));
+
+    if (NULL == r) return NULL;
+    r->root = NULL;
+    r->spare = NULL;
+    r->nspare = 0;
+    r->seed = 0x9e3779b9u ^ (uint32_t)(uintptr_t)r;
+    if (0 == r->seed) r->seed = 1;
+    return r;
+}
+
+ikstr_rope *ikstr_rope_new_len(const void *init, size_t len) {
+    ikstr_rope *r = ikstr_rope_new();
+
+    if (NULL == r) return NULL;
+    if (ikstr_rope_insert_len(r, 0, init, len) != 0) {
+        ikstr_rope_free(r);
+        return NULL;
+    }
+    return r;
+}
+
+void ikstr_rope_free(ikstr_rope *r) {
+    if (NULL == r) return;
+    ikstr_rope_release(r->root);
+    while (r->nspare) iks_free_sized(ikstr_rope_take(r), sizeof(ikstr_rope_node));
+    iks_free_sized(r, sizeof(ikstr_rope));
+}
+
+size_t ikstr_rope_len(const ikstr_rope *r) {
+    return ikstr_rope_total(r->root);
+}
+
+/*
+ * Appends a small insertion to the piece ending at `pos` when that piece
+ * ends its chunk and nothing else references the chunk or the path to it.
+ * Returns 0 if the fast path does not apply.
+ */
+static int ikstr_rope_extend(ikstr_rope *r, size_t pos, const void *p, size_t len) {
+    ikstr_rope_node *t = r->root, *hit = NULL;
+    size_t q = pos;
+    ikstr d;
+
+    if (len > IKSTR_ROPE_SMALL) return 0;
+    while (t && NULL == hit) {
+        size_t lsz = ikstr_rope_total(t->left);
+
+        if (ikstr_ref_load(&t->refs) != 1) return 0;
+        if (q <= lsz) {
+            t = t->left;
+        } else if (q < lsz + t->len) {
+            return 0;
+        } else if (q == lsz + t->len) {
+            hit = t;
+        } else {
+            q -= lsz + t->len;
+            t = t->right;
+        }
+    }
+    if (NULL == hit || hit->len + len > IKSTR_ROPE_CHUNK || ikstr_refcount(hit->data) != 1
+        || hit->off + hit->len != ikstr_len(hit->data))
+        return 0;
+
+    d = ikstr_concat_len(hit->data, p, len);
+    if (NULL == d) return 0;
+    hit->data = d;
+    hit->len += len;
+
+    // Same path again, now fixing the subtree sizes
+    for (t = r->root, q = pos; t != hit;) {
+        size_t lsz = ikstr_rope_total(t->left);
+
+        t->total += len;
+        if (q <= lsz) {
+            t = t->left;
+        } else {
+            q -= lsz + t->len;
+            t = t->right;
+        }
+    }
+    hit->total += len;
+    return 1;
+}
+
+/*
+ * Inserts a chunk at `pos`, taking over the caller's reference to `data`.
+ */
+static int ikstr_rope_insert_chunk(ikstr_rope *r, size_t pos, ikstr data, size_t len) {
+    ikstr_rope_node *n, *l, *g;
+
+    if (!ikstr_rope_reserve(r, ikstr_rope_path(r->root, pos) + 1)) {
+        ikstr_free(data);
+        return -1;
+    }
+    n = ikstr_rope_take(r);
+    n->left = n->right = NULL;
+    n->refs = 1;
+    n->data = data;
+    n->off = 0;
+    n->len = len;
+    n->prio = ikstr_rope_prio(r);
+    ikstr_rope_update(n);
+
+    ikstr_rope_split(r, r->root, pos, &l, &g);
+    r->root = ikstr_rope_merge(ikstr_rope_merge(l, n), g);
+    return 0;
+}
+
+int ikstr_rope_insert_len(ikstr_rope *r, size_t pos, const void *p, size_t len) {
+    ikstr data;
+
+    if (pos > ikstr_rope_len(r)) return -1;
+    if (len == 0 || ikstr_rope_extend(r, pos, p, len)) return 0;
+
+    // Reserve before copying, so a failure does not waste the copy
+    if (!ikstr_rope_reserve(r, ikstr_rope_path(r->root, pos) + 1)) return -1;
+    data = ikstr_new_shared_len(p, len);
+    if (NULL == data) return -1;
+    return ikstr_rope_insert_chunk(r, pos, data, len);
+}
+
+int ikstr_rope_insert(ikstr_rope *r, size_t pos, ikstr s) {
+    size_t len = ikstr_len(s);
+
+    if (!(s[-1] & IKSTR_FLAG_SHARED)) return ikstr_rope_insert_len(r, pos, s, len);
+    if (pos > ikstr_rope_len(r)) return -1;
+    if (len == 0) return 0;
+    return ikstr_rope_insert_chunk(r, pos, ikstr_retain(s), len);
+}
+
+int ikstr_rope_append_len(ikstr_rope *r, const void *p, size_t len) {
+    return ikstr_rope_insert_len(r, ikstr_rope_len(r), p, len);
+}
+
+int ikstr_rope_erase(ikstr_rope *r, size_t pos, size_t len) {
+    size_t total = ikstr_rope_len(r);
+    ikstr_rope_node *l, *m, *g;
+
+    if (pos >= total || len == 0) return 0;
+    if (len > total - pos) len = total - pos;
+
+    if (!ikstr_rope_reserve(r, ikstr_rope_path(r->root, pos))) return -1;
+    ikstr_rope_split(r, r->root, pos, &l, &g);
+    if (!ikstr_rope_reserve(r, ikstr_rope_path(g, len))) {
+        r->root = ikstr_rope_merge(l, g);
+        return -1;
+    }
+    ikstr_rope_split(r, g, len, &m, &g);
+    ikstr_rope_release(m);
+    r->root = ikstr_rope_merge(l, g);
+    return 0;
+}
+
+ikstr_rope *ikstr_rope_substr(const ikstr_rope *r, size_t pos, size_t len) {
+    size_t total = ikstr_rope_len(r);
+    ikstr_rope *n = ikstr_rope_new();
+    ikstr_rope_node *l, *g;
+
+    if (NULL == n) return NULL;
+    if (pos >= total || len == 0) return n;
+    if (len > total - pos) len = total - pos;
+
+    // Start from the whole tree, shared, and cut away both ends
+    n->root = r->root;
+    ikstr_ref_inc(&n->root->refs);
+    if (!ikstr_rope_reserve(n, ikstr_rope_path(n->root, pos))) goto fail;
+    ikstr_rope_split(n, n->root, pos, &l, &n->root);
+    ikstr_rope_release(l);
+    if (!ikstr_rope_reserve(n, ikstr_rope_path(n->root, len))) goto fail;
+    ikstr_rope_split(n, n->root, len, &n->root, &g);
+    ikstr_rope_release(g);
+    return n;
+
+    fail:
+    ikstr_rope_free(n);
+    return NULL;
+}
+
+char ikstr_rope_at(const ikstr_rope *r, size_t pos) {
+    const ikstr_rope_node *t = r->root;
+
+    for (;;) {
+        size_t lsz = ikstr_rope_total(t->left);
+
+        if (pos < lsz) {
+            t = t->left;
+        } else if (pos < lsz + t->len) {
+            return t->data[t->off + pos - lsz];
+        } else {
+            pos -= lsz + t->len;
+            t = t->right;
+        }
+    }
+}
+
+static char *ikstr_rope_copy_out(const ikstr_rope_node *t, char *out) {
+    if (NULL == t) return out;
+    out = ikstr_rope_copy_out(t->left, out);
+    memcpy(out, t->data + t->off, t->len);
+    return ikstr_rope_copy_out(t->right, out + t->len);
+}
+
+ikstr ikstr_rope_flatten(const ikstr_rope *r) {
+    ikstr s = ikstr_new_len(IKSTR_NO_INIT, ikstr_rope_len(r));
+
+    if (NULL == s) return NULL;
+    ikstr_rope_copy_out(r->root, s);
+    return s;
+}
+
+size_t ikstr_rope_chunks(const ikstr_rope *r) {
+    return r->root ? r->root->chunks : 0;
+}
+
+void ikstr_rope_iter_init(ikstr_rope_iter *it, const ikstr_rope *r) {
+    it->r = r;
+    it->pos = 0;
+}
+
+int ikstr_rope_iter_next(ikstr_rope_iter *it, const char **ptr, size_t *len) {
+    const ikstr_rope_node *t = it->r->root;
+    size_t pos = it->pos;
+
+    if (pos >= ikstr_rope_len(it->r)) return 0;
+    for (;;) {
+        size_t lsz = ikstr_rope_total(t->left);
+
+        if (pos < lsz) {
+            t = t->left;
+        } else if (pos < lsz + t->len) {
+            *ptr = t->data + t->off + (pos - lsz);
+            *len = t->len - (pos - lsz);
+            it->pos += *len;
+            return 1;
+        } else {
+            pos -= lsz + t->len;
+            t = t->right;
+        }
+    }
+}
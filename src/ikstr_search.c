@@ -0,0 +1,349 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_internal.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#   define IKSTR_HAVE_SSE2 1
+#   include <emmintrin.h>
+#endif
+// The AVX2 search falls back to the SSE2 one for its tail
+#if defined(IKSTR_HAVE_SSE2) && defined(__GNUC__)
+#   define IKSTR_HAVE_AVX2 1
+#   include <immintrin.h>
+#endif
+/*
+ * Scalar search for needles of two or more bytes: memchr for the first byte,
+ * then a check of the last byte before the full comparison.
+ */
+static const char *ikstr_memmem_scalar(const char *h, size_t hl, const char *n, size_t nl) {
+    const char *p, *last = h + hl - nl;
+
+    for (p = h; p <= last; ++p) {
+        p = memchr(p, n[0], (size_t)(last - p) + 1);
+        if (NULL == p) return NULL;
+        if (p[nl - 1] == n[nl - 1] && memcmp(p + 1, n + 1, nl - 2) == 0) return p;
+    }
+    return NULL;
+}
+
+#ifdef IKSTR_HAVE_SSE2
+/*
+ * Compares 16 candidate positions at once: a position survives only if both
+ * the first and the last byte of the needle match, and is then verified.
+ */
+static const char *ikstr_memmem_sse2(const char *h, size_t hl, const char *n, size_t nl) {
+    const __m128i first = _mm_set1_epi8(n[0]);
+    const __m128i last = _mm_set1_epi8(n[nl - 1]);
+    size_t i = 0, end = hl - nl + 1; // number of candidate positions
+
+    for (; i + 16 <= end; i += 16) {
+        __m128i bf = _mm_loadu_si128((const __m128i *)(h + i));
+        __m128i bl = _mm_loadu_si128((const __m128i *)(h + i + nl - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(bf, first), _mm_cmpeq_epi8(bl, last)));
+
+        while (mask) {
+            unsigned bit = ikstr_ctz(mask);
+            if (memcmp(h + i + bit + 1, n + 1, nl - 2) == 0) return h + i + bit;
+            mask &= mask - 1;
+        }
+    }
+    if (i < end) return ikstr_memmem_scalar(h + i, hl - i, n, nl);
+    return NULL;
+}
+#endif
+
+#ifdef IKSTR_HAVE_AVX2
+/*
+ * AVX2 version of ikstr_memmem_sse2, 32 candidate positions per iteration.
+ */
+__attribute__((target("avx2")))
+static const char *ikstr_memmem_avx2(const char *h, size_t hl, const char *n, size_t nl) {
+    const __m256i first = _mm256_set1_epi8(n[0]);
+    const __m256i last = _mm256_set1_epi8(n[nl - 1]);
+    size_t i = 0, end = hl - nl + 1; // number of candidate positions
+
+    for (; i + 32 <= end; i += 32) {
+        __m256i bf = _mm256_loadu_si256((const __m256i *)(h + i));
+        __m256i bl = _mm256_loadu_si256((const __m256i *)(h + i + nl - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(bf, first), _mm256_cmpeq_epi8(bl, last)));
+
+        while (mask) {
+            unsigned bit = ikstr_ctz(mask);
+            if (memcmp(h + i + bit + 1, n + 1, nl - 2) == 0) return h + i + bit;
+            mask &= mask - 1;
+        }
+    }
+    if (i < end) return ikstr_memmem_sse2(h + i, hl - i, n, nl);
+    return NULL;
+}
+#endif
+
+/*
+ * Two-Way string matching (Crochemore-Perrin) for long needles: O(hl + nl)
+ * worst case with O(1) extra space besides a bad-character shift table,
+ * which lets it skip ahead on the last byte like Horspool does.
+ *
+ * Adapted from twoway_memmem in musl's src/string/memmem.c:
+ *
+ * Copyright © 2005-2020 Rich Felker, et al.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+static const char *ikstr_memmem_twoway(const char *hay, size_t hl, const char *ndl, size_t nl) {
+    const unsigned char *h = (const unsigned char *)hay, *n = (const unsigned char *)ndl;
+    const unsigned char *z = h + hl;
+    size_t i, ip, jp, k, p, ms, p0, mem, mem0;
+    size_t shift[256];
+    unsigned char byteset[256] = {0};
+
+    for (i = 0; i < nl; i++) {
+        byteset[n[i]] = 1;
+        shift[n[i]] = i + 1;
+    }
+
+    // Maximal suffix for '<'
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while (jp + k < nl) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else k++;
+        } else if (n[ip + k] > n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    ms = ip;
+    p0 = p;
+
+    // Maximal suffix for '>'
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while (jp + k < nl) {
+        if (n[ip + k] == n[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else k++;
+        } else if (n[ip + k] < n[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    // The critical factorization is the later of the two
+    if (ip + 1 > ms + 1) ms = ip;
+    else p = p0;
+
+    // Is the needle periodic with period p?
+    if (memcmp(n, n + p, ms + 1)) {
+        mem0 = 0;
+        p = (ms > nl - ms - 1 ? ms : nl - ms - 1) + 1;
+    } else mem0 = nl - p;
+    mem = 0;
+
+    for (;;) {
+        if ((size_t)(z - h) < nl) return NULL;
+
+        // Check the last byte first and skip on mismatch
+        if (byteset[h[nl - 1]]) {
+            k = nl - shift[h[nl - 1]];
+            if (k) {
+                if (k < mem) k = mem;
+                h += k;
+                mem = 0;
+                continue;
+            }
+        } else {
+            h += nl;
+            mem = 0;
+            continue;
+        }
+
+        // Right half
+        for (k = (ms + 1 > mem ? ms + 1 : mem); k < nl && n[k] == h[k]; k++);
+        if (k < nl) {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+        // Left half
+        for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; k--);
+        if (k <= mem) return (const char *)h;
+        h += p;
+        mem = mem0;
+    }
+}
+
+typedef const char *(*ikstr_memmem_fn)(const char *, size_t, const char *, size_t);
+
+static const char *ikstr_memmem_resolve(const char *h, size_t hl, const char *n, size_t nl);
+
+/*
+ * Short-needle implementation, picked on first use from the features of the
+ * running CPU. Concurrent first calls all store the same value.
+ */
+static ikstr_memmem_fn ikstr_memmem_short = ikstr_memmem_resolve;
+
+static const char *ikstr_memmem_resolve(const char *h, size_t hl, const char *n, size_t nl) {
+    ikstr_memmem_fn fn = ikstr_memmem_scalar;
+#ifdef IKSTR_HAVE_SSE2
+    fn = ikstr_memmem_sse2;
+#endif
+#ifdef IKSTR_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) fn = ikstr_memmem_avx2;
+#endif
+    ikstr_memmem_short = fn;
+    return fn(h, hl, n, nl);
+}
+
+const char *ikstr_memmem(const char *h, size_t hl, const char *n, size_t nl) {
+    if (nl > hl) return NULL;
+    // libc memchr is already vectorized for the single byte case
+    if (nl == 1) return memchr(h, n[0], hl);
+    // The first/last byte filter degrades to O(hl * nl) on adversarial input,
+    // so only use it while nl keeps that bounded
+    if (nl <= IKSTR_SHORT_NEEDLE) return ikstr_memmem_short(h, hl, n, nl);
+    return ikstr_memmem_twoway(h, hl, n, nl);
+}
+
+const char *ikstr_memrchr(const char *h, size_t hl, int c) {
+    const char *p = h + hl;
+
+    while (p > h) {
+        if (*--p == (char)c) return p;
+    }
+    return NULL;
+}
+
+const char *ikstr_memrmem(const char *h, size_t hl, const char *n, size_t nl) {
+    size_t shift[256], i, pos;
+    const unsigned char *un = (const unsigned char *)n;
+
+    if (nl > hl) return NULL;
+    if (nl == 1) return ikstr_memrchr(h, hl, n[0]);
+
+    // Horspool on the reversed strings: align the needle at the end of the
+    // haystack and shift left by how far its first byte occurs from the front
+    for (i = 0; i < 256; i++) shift[i] = nl;
+    for (i = nl - 1; i > 0; i--) shift[un[i]] = i;
+
+    pos = hl - nl;
+    for (;;) {
+        if (h[pos] == n[0] && memcmp(h + pos + 1, n + 1, nl - 1) == 0) return h + pos;
+        i = shift[(unsigned char)h[pos]];
+        if (pos < i) return NULL;
+        pos -= i;
+    }
+}
+
+/*
+ * Runs shorter than this are scanned bytewise; longer ones switch to 16-byte
+ * compares against each member of the set, as long as it has at most
+ * IKSTR_SPAN_MEMBERS members (typical whitespace/padding sets).
+ */
+#define IKSTR_SPAN_SCALAR 16
+#define IKSTR_SPAN_MEMBERS 8
+
+#ifdef IKSTR_HAVE_SSE2
+/*
+ * Loads the members of `cs` as broadcast vectors. Returns their number, or 0
+ * if there are more than IKSTR_SPAN_MEMBERS.
+ */
+static size_t ikstr_span_members(const ikstr_charset *cs, __m128i *out) {
+    size_t n = 0;
+
+    for (unsigned w = 0; w < 4; ++w) {
+        uint64_t bits = cs->bits[w];
+        while (bits) {
+            unsigned lo = (unsigned)bits;
+            unsigned b = lo ? ikstr_ctz(lo) : 32 + ikstr_ctz((unsigned)(bits >> 32));
+            if (n == IKSTR_SPAN_MEMBERS) return 0;
+            out[n++] = _mm_set1_epi8((char)(w * 64 + b));
+            bits &= bits - 1;
+        }
+    }
+    return n;
+}
+
+/*
+ * Returns a mask with a bit set for every byte of `b` that is NOT a member.
+ */
+static inline unsigned ikstr_span_miss(__m128i b, const __m128i *m, size_t k) {
+    __m128i hit = _mm_cmpeq_epi8(b, m[0]);
+    for (size_t j = 1; j < k; ++j) hit = _mm_or_si128(hit, _mm_cmpeq_epi8(b, m[j]));
+    return ~(unsigned)_mm_movemask_epi8(hit) & 0xffffu;
+}
+#endif
+
+size_t ikstr_span(const char *p, size_t n, const ikstr_charset *cs) {
+    size_t i = 0;
+
+    for (; i < n && i < IKSTR_SPAN_SCALAR; ++i) {
+        if (!ikstr_charset_has(cs, (unsigned char)p[i])) return i;
+    }
+#ifdef IKSTR_HAVE_SSE2
+    if (n - i >= 16) {
+        __m128i m[IKSTR_SPAN_MEMBERS];
+        size_t k = ikstr_span_members(cs, m);
+
+        for (; k && i + 16 <= n; i += 16) {
+            unsigned miss = ikstr_span_miss(_mm_loadu_si128((const __m128i *)(p + i)), m, k);
+            if (miss) return i + ikstr_ctz(miss);
+        }
+    }
+#endif
+    while (i < n && ikstr_charset_has(cs, (unsigned char)p[i])) ++i;
+    return i;
+}
+
+size_t ikstr_rspan(const char *p, size_t n, const ikstr_charset *cs) {
+    size_t i = 0; // bytes matched from the end
+
+    for (; i < n && i < IKSTR_SPAN_SCALAR; ++i) {
+        if (!ikstr_charset_has(cs, (unsigned char)p[n - i - 1])) return i;
+    }
+#ifdef IKSTR_HAVE_SSE2
+    if (n - i >= 16) {
+        __m128i m[IKSTR_SPAN_MEMBERS];
+        size_t k = ikstr_span_members(cs, m);
+
+        for (; k && i + 16 <= n; i += 16) {
+            unsigned miss = ikstr_span_miss(_mm_loadu_si128((const __m128i *)(p + n - i - 16)), m, k);
+            if (miss) return i + 15 - ikstr_bsr(miss);
+        }
+    }
+#endif
+    while (i < n && ikstr_charset_has(cs, (unsigned char)p[n - i - 1])) ++i;
+    return i;
+}
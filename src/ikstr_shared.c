@@ -0,0 +1,87 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+
+ikstr ikstr_new_shared_len(const void *init, size_t len) {
+    unsigned char type = (unsigned char)ikstr_req_type(len);
+    size_t hdr_len = ikstr_hdr_size(type);
+    char *sh;
+
+    sh = iks_malloc(sizeof(struct ikstr_ext) + hdr_len + len + 1);
+    if (NULL == sh) return NULL;
+    ((struct ikstr_ext *)sh)->refs = 1;
+    sh += sizeof(struct ikstr_ext) + hdr_len;
+    ikstr_init_hdr(sh, type | IKSTR_FLAG_SHARED, len, len);
+    if (len) memcpy(sh, init, len);
+    IKSTR_STAT_ADD(bytes_copied, len);
+    sh[len] = '\0';
+    return sh;
+}
+
+ikstr ikstr_share(ikstr *s) {
+    ikstr t = *s;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_SHARE);
+    if (t[-1] & IKSTR_FLAG_SHARED) {
+        ikstr_ref_inc(&ikstr_ext_of(t)->refs);
+        return t;
+    }
+
+    // Move into a block with a reference count in front of the header
+    t = ikstr_new_shared_len(t, ikstr_len(t));
+    if (NULL == t) return NULL;
+    ikstr_ext_of(t)->refs = 2;
+    ikstr_free(*s);
+    *s = t;
+    return t;
+}
+
+ikstr ikstr_retain(ikstr s) {
+    if (s[-1] & IKSTR_FLAG_SHARED) ikstr_ref_inc(&ikstr_ext_of(s)->refs);
+    return s;
+}
+
+void ikstr_release(ikstr s) {
+    ikstr_free(s);
+}
+
+size_t ikstr_refcount(ikstr s) {
+    if (s[-1] & IKSTR_FLAG_SHARED) return ikstr_ref_load(&ikstr_ext_of(s)->refs);
+    return 1;
+}
+
+ikstr ikstr_unshare_slow(ikstr s, size_t addlen) {
+    size_t len, cap, hdr_len;
+    unsigned char type;
+    char *sh;
+
+    // The only reference: keep the block, it can be modified in place
+    if (!(s[-1] & IKSTR_FLAG_MAPPED) && ikstr_ref_load(&ikstr_ext_of(s)->refs) == 1) {
+        s[-1] = (char)(s[-1] & ~IKSTR_FLAG_HASHED);
+        return s;
+    }
+
+    len = ikstr_len(s);
+    cap = len + addlen;
+    if (cap < len) // size_t overflow
+        return NULL;
+    if (addlen) cap = ikstr_grow_len(len, cap);
+    type = (unsigned char)ikstr_req_type(cap);
+    hdr_len = ikstr_hdr_size(type);
+    if (hdr_len + cap + 1 <= cap) // size_t overflow
+        return NULL;
+    sh = iks_malloc(hdr_len + cap + 1);
+    if (NULL == sh) return NULL;
+
+    sh += hdr_len;
+    ikstr_init_hdr(sh, type, len, cap);
+    memcpy(sh, s, len + 1);
+    IKSTR_STAT_ADD(bytes_copied, len);
+    ikstr_free(s); // drops our reference (or the mapping), frees if the others went away meanwhile
+    return sh;
+}
@@ -0,0 +1,126 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#   define _POSIX_C_SOURCE 200809L // pthread_key_t
+#endif
+#include "ikstr_stats.h"
+#include "ikstr_internal.h"
+#include <string.h>
+
+#ifdef IKSTR_STATS
+
+#if defined(_WIN32)
+#   include <windows.h>
+typedef SRWLOCK ikstr_mutex;
+#   define IKSTR_MUTEX_INIT SRWLOCK_INIT
+#   define ikstr_mutex_lock(l) AcquireSRWLockExclusive(l)
+#   define ikstr_mutex_unlock(l) ReleaseSRWLockExclusive(l)
+#else
+#   include <pthread.h>
+typedef pthread_mutex_t ikstr_mutex;
+#   define IKSTR_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#   define ikstr_mutex_lock(l) pthread_mutex_lock(l)
+#   define ikstr_mutex_unlock(l) pthread_mutex_unlock(l)
+#endif
+
+enum {
+    IKSTR_STATS_NEW,   // not registered yet
+    IKSTR_STATS_LIVE,  // registered, with the thread exit hook set
+    IKSTR_STATS_DEAD,  // folded into the totals on thread exit, or never summed
+};
+
+IKSTR_THREAD_LOCAL IKSTR_TLS_INITIAL_EXEC struct ikstr_stats_local ikstr_stats_tls;
+
+static ikstr_mutex ikstr_stats_lock = IKSTR_MUTEX_INIT;
+static struct ikstr_stats_local *ikstr_stats_live; // guarded by ikstr_stats_lock
+static ikstr_stats ikstr_stats_retired;            // counters of exited threads, same
+static int ikstr_stats_hook_ready;                 // same
+#if defined(_WIN32)
+static DWORD ikstr_stats_hook;
+#else
+static pthread_key_t ikstr_stats_hook;
+#endif
+
+/*
+ * Adds the counters of `src` to `dst`, reading them with relaxed loads since
+ * their owner may be updating them.
+ */
+static void ikstr_stats_add(ikstr_stats *dst, const ikstr_stats *src) {
+    dst->allocs += ikstr_relaxed_load(&src->allocs);
+    dst->reallocs += ikstr_relaxed_load(&src->reallocs);
+    dst->frees += ikstr_relaxed_load(&src->frees);
+    dst->alloc_bytes += ikstr_relaxed_load(&src->alloc_bytes);
+    dst->migrations += ikstr_relaxed_load(&src->migrations);
+    dst->bytes_copied += ikstr_relaxed_load(&src->bytes_copied);
+    dst->slack_bytes += ikstr_relaxed_load(&src->slack_bytes);
+    for (int i = 0; i < IKSTR_CALL_COUNT; ++i) dst->calls[i] += ikstr_relaxed_load(&src->calls[i]);
+}
+
+#if defined(_WIN32)
+static void WINAPI ikstr_stats_thread_exit(void *arg) {
+#else
+static void ikstr_stats_thread_exit(void *arg) {
+#endif
+    struct ikstr_stats_local *l = arg;
+
+    if (NULL == l) return;
+    ikstr_mutex_lock(&ikstr_stats_lock);
+    if (l->prev) l->prev->next = l->next;
+    else ikstr_stats_live = l->next;
+    if (l->next) l->next->prev = l->prev;
+    ikstr_stats_add(&ikstr_stats_retired, &l->st);
+    ikstr_mutex_unlock(&ikstr_stats_lock);
+    // Later updates from this thread (e.g. other exit hooks) are not counted
+    l->state = IKSTR_STATS_DEAD;
+}
+
+void ikstr_stats_register(struct ikstr_stats_local *l) {
+    ikstr_mutex_lock(&ikstr_stats_lock);
+    if (!ikstr_stats_hook_ready) {
+#if defined(_WIN32)
+        ikstr_stats_hook = FlsAlloc(ikstr_stats_thread_exit);
+        ikstr_stats_hook_ready = FLS_OUT_OF_INDEXES != ikstr_stats_hook;
+#else
+        ikstr_stats_hook_ready = pthread_key_create(&ikstr_stats_hook, ikstr_stats_thread_exit) == 0;
+#endif
+    }
+    // Without the exit hook the counters could not be unlinked before the
+    // thread goes away, so they are kept but never summed
+    if (!ikstr_stats_hook_ready) {
+        ikstr_mutex_unlock(&ikstr_stats_lock);
+        l->state = IKSTR_STATS_DEAD;
+        return;
+    }
+    l->prev = NULL;
+    l->next = ikstr_stats_live;
+    if (ikstr_stats_live) ikstr_stats_live->prev = l;
+    ikstr_stats_live = l;
+    ikstr_mutex_unlock(&ikstr_stats_lock);
+
+#if defined(_WIN32)
+    FlsSetValue(ikstr_stats_hook, l);
+#else
+    pthread_setspecific(ikstr_stats_hook, l);
+#endif
+    l->state = IKSTR_STATS_LIVE;
+}
+
+int ikstr_stats_snapshot(ikstr_stats *st) {
+    memset(st, 0, sizeof(*st));
+    ikstr_mutex_lock(&ikstr_stats_lock);
+    ikstr_stats_add(st, &ikstr_stats_retired);
+    for (struct ikstr_stats_local *l = ikstr_stats_live; l; l = l->next) ikstr_stats_add(st, &l->st);
+    ikstr_mutex_unlock(&ikstr_stats_lock);
+    return 0;
+}
+
+#else
+
+int ikstr_stats_snapshot(ikstr_stats *st) {
+    memset(st, 0, sizeof(*st));
+    return -1;
+}
+
+#endif
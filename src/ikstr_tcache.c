@@ -0,0 +1,258 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#   define _POSIX_C_SOURCE 200809L // pthread_key_t
+#endif
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+#if defined(_WIN32)
+#   include <windows.h>
+typedef SRWLOCK ikstr_mutex;
+#   define IKSTR_MUTEX_INIT SRWLOCK_INIT
+#   define ikstr_mutex_lock(l) AcquireSRWLockExclusive(l)
+#   define ikstr_mutex_unlock(l) ReleaseSRWLockExclusive(l)
+#else
+#   include <pthread.h>
+typedef pthread_mutex_t ikstr_mutex;
+#   define IKSTR_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#   define ikstr_mutex_lock(l) pthread_mutex_lock(l)
+#   define ikstr_mutex_unlock(l) pthread_mutex_unlock(l)
+#endif
+
+#define IKSTR_TCACHE_CLASSES (IKSTR_TCACHE_MAX_SIZE / 16)
+
+enum {
+    IKSTR_TC_NEW,   // not registered yet
+    IKSTR_TC_LIVE,  // registered, with the thread exit hook set
+    IKSTR_TC_DEAD,  // flushed by the thread exit hook, bypassed from now on
+};
+
+/*
+ * Free lists of one thread, one per 16-byte size class. Free blocks are
+ * linked through their first word. Only the owning thread touches the lists;
+ * the counters are also read by ikstr_tcache_get_stats, so the owner writes
+ * them with relaxed atomic stores.
+ */
+struct ikstr_tcache {
+    void *heads[IKSTR_TCACHE_CLASSES];
+    size_t counts[IKSTR_TCACHE_CLASSES];
+    ikstr_tcache_stats st;
+    struct ikstr_tcache *prev, *next; // registry of live caches
+    int state;
+};
+
+// The cache is touched on every small allocation
+static IKSTR_THREAD_LOCAL IKSTR_TLS_INITIAL_EXEC struct ikstr_tcache ikstr_tc;
+
+static ikstr_mutex ikstr_tc_lock = IKSTR_MUTEX_INIT;
+static struct ikstr_tcache *ikstr_tc_live;  // guarded by ikstr_tc_lock
+static ikstr_tcache_stats ikstr_tc_retired; // counters of exited threads, same
+static const ikstr_allocator *ikstr_tc_backing;
+static size_t ikstr_tc_max_size = IKSTR_TCACHE_MAX_SIZE;
+static size_t ikstr_tc_max_blocks = IKSTR_TCACHE_BLOCKS;
+static int ikstr_tc_hook_ready;
+#if defined(_WIN32)
+static DWORD ikstr_tc_hook;
+#else
+static pthread_key_t ikstr_tc_hook;
+#endif
+
+static inline size_t ikstr_tc_class(size_t size) {
+    return size ? (size - 1) >> 4 : 0;
+}
+
+static inline size_t ikstr_tc_class_size(size_t c) {
+    return (c + 1) << 4;
+}
+
+static void ikstr_tc_backing_release(void *ptr, size_t size) {
+    const ikstr_allocator *a = ikstr_tc_backing;
+
+    if (a->release_sized) a->release_sized(a->ctx, ptr, size);
+    else a->release(a->ctx, ptr);
+}
+
+static void ikstr_tc_flush(struct ikstr_tcache *tc) {
+    for (size_t c = 0; c < IKSTR_TCACHE_CLASSES; ++c) {
+        void *p = tc->heads[c];
+
+        while (p) {
+            void *next = *(void **)p;
+            ikstr_tc_backing_release(p, ikstr_tc_class_size(c));
+            p = next;
+        }
+        ikstr_relaxed_add(&tc->st.cached, (size_t)0 - tc->counts[c]);
+        tc->heads[c] = NULL;
+        tc->counts[c] = 0;
+    }
+}
+
+#if defined(_WIN32)
+static void WINAPI ikstr_tc_thread_exit(void *arg) {
+#else
+static void ikstr_tc_thread_exit(void *arg) {
+#endif
+    struct ikstr_tcache *tc = arg;
+
+    if (NULL == tc) return;
+    ikstr_tc_flush(tc);
+    tc->state = IKSTR_TC_DEAD;
+
+    ikstr_mutex_lock(&ikstr_tc_lock);
+    if (tc->prev) tc->prev->next = tc->next;
+    else ikstr_tc_live = tc->next;
+    if (tc->next) tc->next->prev = tc->prev;
+    ikstr_tc_retired.hits += tc->st.hits;
+    ikstr_tc_retired.misses += tc->st.misses;
+    ikstr_tc_retired.frees += tc->st.frees;
+    ikstr_tc_retired.overflows += tc->st.overflows;
+    ikstr_mutex_unlock(&ikstr_tc_lock);
+}
+
+/*
+ * Adds the cache of the calling thread to the registry and arms the thread
+ * exit hook, on its first cacheable allocation or free.
+ */
+static void ikstr_tc_register(struct ikstr_tcache *tc) {
+    ikstr_mutex_lock(&ikstr_tc_lock);
+    tc->prev = NULL;
+    tc->next = ikstr_tc_live;
+    if (ikstr_tc_live) ikstr_tc_live->prev = tc;
+    ikstr_tc_live = tc;
+    ikstr_mutex_unlock(&ikstr_tc_lock);
+#if defined(_WIN32)
+    FlsSetValue(ikstr_tc_hook, tc);
+#else
+    pthread_setspecific(ikstr_tc_hook, tc);
+#endif
+    tc->state = IKSTR_TC_LIVE;
+}
+
+static void *ikstr_tcache_alloc(void *ctx, size_t size) {
+    struct ikstr_tcache *tc = &ikstr_tc;
+    size_t c;
+    void *p;
+
+    (void)ctx;
+    if (size > ikstr_tc_max_size) return ikstr_tc_backing->alloc(ikstr_tc_backing->ctx, size);
+
+    c = ikstr_tc_class(size);
+    p = tc->heads[c];
+    if (p) {
+        tc->heads[c] = *(void **)p;
+        --tc->counts[c];
+        ikstr_relaxed_add(&tc->st.hits, 1);
+        ikstr_relaxed_add(&tc->st.cached, (size_t)-1);
+        return p;
+    }
+    if (IKSTR_TC_NEW == tc->state) ikstr_tc_register(tc);
+    if (IKSTR_TC_LIVE == tc->state) ikstr_relaxed_add(&tc->st.misses, 1);
+    // Always the full class size, since any thread may cache the block later
+    return ikstr_tc_backing->alloc(ikstr_tc_backing->ctx, ikstr_tc_class_size(c));
+}
+
+static void ikstr_tcache_release_sized(void *ctx, void *ptr, size_t size) {
+    struct ikstr_tcache *tc = &ikstr_tc;
+    size_t c;
+
+    (void)ctx;
+    if (size > ikstr_tc_max_size) {
+        ikstr_tc_backing_release(ptr, size);
+        return;
+    }
+
+    c = ikstr_tc_class(size);
+    if (IKSTR_TC_NEW == tc->state) ikstr_tc_register(tc);
+    if (IKSTR_TC_LIVE != tc->state || tc->counts[c] >= ikstr_tc_max_blocks) {
+        if (IKSTR_TC_LIVE == tc->state) ikstr_relaxed_add(&tc->st.overflows, 1);
+        ikstr_tc_backing_release(ptr, ikstr_tc_class_size(c));
+        return;
+    }
+    *(void **)ptr = tc->heads[c];
+    tc->heads[c] = ptr;
+    ++tc->counts[c];
+    ikstr_relaxed_add(&tc->st.frees, 1);
+    ikstr_relaxed_add(&tc->st.cached, 1);
+}
+
+static void ikstr_tcache_release(void *ctx, void *ptr) {
+    // Without a size the class is unknown; every cached block is a whole
+    // backing block, so it can go straight back
+    (void)ctx;
+    ikstr_tc_backing->release(ikstr_tc_backing->ctx, ptr);
+}
+
+static void *ikstr_tcache_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    void *p;
+
+    if (old_size <= ikstr_tc_max_size && new_size <= ikstr_tc_max_size) {
+        if (ikstr_tc_class(old_size) == ikstr_tc_class(new_size)) return ptr;
+    } else if (old_size > ikstr_tc_max_size && new_size > ikstr_tc_max_size && ikstr_tc_backing->resize) {
+        return ikstr_tc_backing->resize(ikstr_tc_backing->ctx, ptr, old_size, new_size);
+    }
+
+    p = ikstr_tcache_alloc(ctx, new_size);
+    if (NULL == p) return NULL;
+    memcpy(p, ptr, old_size < new_size ? old_size : new_size);
+    ikstr_tcache_release_sized(ctx, ptr, old_size);
+    return p;
+}
+
+static size_t ikstr_tcache_usable_size(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    if (size <= ikstr_tc_max_size) return ikstr_tc_class_size(ikstr_tc_class(size));
+    if (ikstr_tc_backing->usable_size) return ikstr_tc_backing->usable_size(ikstr_tc_backing->ctx, ptr, size);
+    return size;
+}
+
+static const ikstr_allocator ikstr_tcache_allocator = {
+    ikstr_tcache_alloc,
+    ikstr_tcache_resize,
+    ikstr_tcache_release,
+    ikstr_tcache_release_sized,
+    NULL,
+    ikstr_tcache_usable_size,
+};
+
+const ikstr_allocator *ikstr_tcache_init(const ikstr_tcache_config *cfg) {
+    size_t max_size = cfg && cfg->max_size ? cfg->max_size : IKSTR_TCACHE_MAX_SIZE;
+
+    ikstr_mutex_lock(&ikstr_tc_lock);
+    if (!ikstr_tc_hook_ready) {
+#if defined(_WIN32)
+        ikstr_tc_hook = FlsAlloc(ikstr_tc_thread_exit);
+        ikstr_tc_hook_ready = FLS_OUT_OF_INDEXES != ikstr_tc_hook;
+#else
+        ikstr_tc_hook_ready = pthread_key_create(&ikstr_tc_hook, ikstr_tc_thread_exit) == 0;
+#endif
+    }
+    ikstr_mutex_unlock(&ikstr_tc_lock);
+    if (!ikstr_tc_hook_ready) return NULL;
+
+    // Round to a class boundary, so every block of a class has the same size
+    if (max_size > IKSTR_TCACHE_MAX_SIZE) max_size = IKSTR_TCACHE_MAX_SIZE;
+    ikstr_tc_max_size = ikstr_tc_class_size(ikstr_tc_class(max_size));
+    ikstr_tc_max_blocks = cfg && cfg->max_blocks ? cfg->max_blocks : IKSTR_TCACHE_BLOCKS;
+    ikstr_tc_backing = cfg && cfg->backing ? cfg->backing : &ikstr_libc_allocator;
+    return &ikstr_tcache_allocator;
+}
+
+void ikstr_tcache_flush(void) {
+    if (IKSTR_TC_LIVE == ikstr_tc.state) ikstr_tc_flush(&ikstr_tc);
+}
+
+void ikstr_tcache_get_stats(ikstr_tcache_stats *st) {
+    ikstr_mutex_lock(&ikstr_tc_lock);
+    *st = ikstr_tc_retired;
+    for (struct ikstr_tcache *tc = ikstr_tc_live; tc; tc = tc->next) {
+        st->hits += ikstr_relaxed_load(&tc->st.hits);
+        st->misses += ikstr_relaxed_load(&tc->st.misses);
+        st->frees += ikstr_relaxed_load(&tc->st.frees);
+        st->overflows += ikstr_relaxed_load(&tc->st.overflows);
+        st->cached += ikstr_relaxed_load(&tc->st.cached);
+    }
+    ikstr_mutex_unlock(&ikstr_tc_lock);
+}
@@ -0,0 +1,246 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#include "ikstr_view.h"
+#include "ikstr_alloc.h"
+#include "ikstr_internal.h"
+#include <string.h>
+
+ikstr ikstr_new_view(ikstr_view v) {
+    return ikstr_new_len(v.ptr, v.len);
+}
+
+int ikstr_view_cmp(ikstr_view a, ikstr_view b) {
+    size_t min_len = a.len < b.len ? a.len : b.len;
+    int cmp = min_len ? memcmp(a.ptr, b.ptr, min_len) : 0;
+    if (cmp) return cmp;
+    return a.len < b.len ? -1 : a.len > b.len ? 1 : 0;
+}
+
+ikstr_view ikstr_view_trim_set(ikstr_view v, const ikstr_charset *cs) {
+    size_t l = ikstr_span(v.ptr, v.len, cs);
+
+    v.ptr += l;
+    v.len -= l;
+    v.len -= ikstr_rspan(v.ptr, v.len, cs);
+    return v;
+}
+
+ikstr_view ikstr_view_trim(ikstr_view v, const char *char_set) {
+    ikstr_charset cs;
+
+    ikstr_charset_init(&cs, char_set);
+    return ikstr_view_trim_set(v, &cs);
+}
+
+ssize_t ikstr_view_find(ikstr_view hay, ikstr_view needle) {
+    const char *p;
+
+    if (needle.len == 0) return 0;
+    p = ikstr_memmem(hay.ptr, hay.len, needle.ptr, needle.len);
+    return p ? p - hay.ptr : -1;
+}
+
+size_t ikstr_split_view(const char *s, size_t len, const char *sep, size_t sep_len,
+                        ikstr_view *out, size_t max) {
+    const char *start = s, *end = s + len, *hit;
+    size_t count = 0;
+
+    if (sep_len == 0 || len == 0) return 0;
+
+    while ((hit = ikstr_memmem(start, (size_t)(end - start), sep, sep_len)) != NULL) {
+        if (count < max) out[count] = ikstr_view_from(start, (size_t)(hit - start));
+        ++count;
+        start = hit + sep_len;
+    }
+    if (count < max) out[count] = ikstr_view_from(start, (size_t)(end - start));
+    return count + 1;
+}
+
+ikstr *ikstr_new_batch(const ikstr_view *items, size_t count) {
+    size_t total, n;
+    ikstr *strs;
+    char *p;
+
+    // The array first, then the strings back to back
+    if (count > SIZE_MAX / sizeof(ikstr)) return NULL;
+    total = count ? count * sizeof(ikstr) : sizeof(ikstr);
+    for (size_t i = 0; i < count; ++i) {
+        n = (size_t)ikstr_hdr_size(ikstr_req_type(items[i].len)) + items[i].len + 1;
+        if (n <= items[i].len || total + n < total) return NULL; // size_t overflow
+        total += n;
+    }
+
+    strs = iks_malloc(total);
+    if (NULL == strs) return NULL;
+    p = (char *)(strs + count);
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char type = ikstr_req_type(items[i].len);
+        ikstr s = p + ikstr_hdr_size(type);
+
+        ikstr_init_hdr(s, type | IKSTR_FLAG_BORROWED, items[i].len, items[i].len);
+        if (items[i].len) memcpy(s, items[i].ptr, items[i].len);
+        IKSTR_STAT_ADD(bytes_copied, items[i].len);
+        s[items[i].len] = '\0';
+        strs[i] = s;
+        p = s + items[i].len + 1;
+    }
+    return strs;
+}
+
+void ikstr_free_batch(ikstr *strs, size_t count) {
+    if (NULL == strs) return;
+    while (count--) ikstr_free(strs[count]);
+    iks_free(strs);
+}
+
+/*
+ * Token views are collected here before being copied into the batch; larger
+ * inputs spill to a growing heap array.
+ */
+#define IKSTR_BATCH_STACK 64
+
+ikstr *ikstr_split_len_batch(const char *s, ssize_t len, const char *sep, int sep_len, int *count) {
+    ikstr_view stack[IKSTR_BATCH_STACK], *views = stack;
+    size_t n = 0, slots = IKSTR_BATCH_STACK;
+    const char *start = s, *end = s + len, *hit;
+    ikstr *result = NULL;
+
+    IKSTR_STAT_CALL(IKSTR_CALL_SPLIT);
+    *count = 0;
+    if (sep_len <= 0 || len <= 0) return NULL;
+
+    for (;;) {
+        hit = ikstr_memmem(start, (size_t)(end - start), sep, (size_t)sep_len);
+        if (n == slots) {
+            ikstr_view *tmp;
+
+            if (n >= INT_MAX) goto done;
+            if (views == stack) {
+                tmp = iks_malloc(sizeof(ikstr_view) * slots * 2);
+                if (tmp) memcpy(tmp, stack, sizeof(stack));
+            } else {
+                tmp = iks_realloc(views, sizeof(ikstr_view) * slots, sizeof(ikstr_view) * slots * 2);
+            }
+            if (NULL == tmp) goto done;
+            views = tmp;
+            slots *= 2;
+        }
+        if (NULL == hit) break;
+        views[n++] = ikstr_view_from(start, (size_t)(hit - start));
+        start = hit + sep_len;
+    }
+    views[n++] = ikstr_view_from(start, (size_t)(end - start));
+
+    result = ikstr_new_batch(views, n);
+    if (result) *count = (int)n;
+
+    done:
+    if (views != stack) iks_free_sized(views, sizeof(ikstr_view) * slots);
+    return result;
+}
+
+void ikstr_split_iter_init_stream(ikstr_split_iter *it, const char *sep, size_t sep_len) {
+    it->sep = sep;
+    it->sep_len = sep_len;
+    it->cur = it->end = NULL;
+    it->carry = NULL;
+    it->finished = 0;
+    it->pending = 0;
+    it->clear_carry = 0;
+}
+
+void ikstr_split_iter_init(ikstr_split_iter *it, const char *s, size_t len,
+                           const char *sep, size_t sep_len) {
+    ikstr_split_iter_init_stream(it, sep, sep_len);
+    ikstr_split_iter_feed(it, s, len);
+    ikstr_split_iter_finish(it);
+}
+
+void ikstr_split_iter_feed(ikstr_split_iter *it, const char *chunk, size_t len) {
+    it->cur = chunk;
+    it->end = chunk + len;
+    if (len) it->pending = 1;
+}
+
+void ikstr_split_iter_finish(ikstr_split_iter *it) {
+    it->finished = 1;
+}
+
+/*
+ * Appends bytes to the carry buffer, creating it on first use.
+ */
+static int ikstr_split_iter_carry(ikstr_split_iter *it, const char *p, size_t len) {
+    ikstr c = it->carry ? ikstr_concat_len(it->carry, p, len) : ikstr_new_len(p, len);
+    if (NULL == c) return -1;
+    it->carry = c;
+    return 0;
+}
+
+int ikstr_split_iter_next(ikstr_split_iter *it, ikstr_view *tok) {
+    const char *sep = it->sep, *hit;
+    size_t sep_len = it->sep_len, avail, carry_len;
+
+    if (it->clear_carry) {
+        ikstr_set_len(it->carry, 0);
+        it->carry[0] = '\0';
+        it->clear_carry = 0;
+    }
+    if (sep_len == 0) return 0;
+
+    avail = (size_t)(it->end - it->cur);
+    carry_len = it->carry ? ikstr_len(it->carry) : 0;
+
+    if (carry_len == 0) {
+        // Fast path: the token lies entirely inside the current chunk
+        hit = avail ? ikstr_memmem(it->cur, avail, sep, sep_len) : NULL;
+        if (hit) {
+            *tok = ikstr_view_from(it->cur, (size_t)(hit - it->cur));
+            it->cur = hit + sep_len;
+            return 1;
+        }
+        if (!it->finished) {
+            if (avail && ikstr_split_iter_carry(it, it->cur, avail)) return -1;
+            it->cur = it->end;
+            return 0;
+        }
+        if (!it->pending) return 0;
+        *tok = ikstr_view_from(it->cur, avail);
+        it->cur = it->end;
+        it->pending = 0;
+        return 1;
+    }
+
+    // A separator may start in the carry and end in this chunk
+    for (size_t k = sep_len - 1 < carry_len ? sep_len - 1 : carry_len; k > 0; --k) {
+        if (avail >= sep_len - k &&
+            memcmp(it->carry + carry_len - k, sep, k) == 0 &&
+            memcmp(it->cur, sep + k, sep_len - k) == 0) {
+            *tok = ikstr_view_from(it->carry, carry_len - k);
+            it->cur += sep_len - k;
+            it->clear_carry = 1;
+            return 1;
+        }
+    }
+
+    hit = avail ? ikstr_memmem(it->cur, avail, sep, sep_len) : NULL;
+    if (hit) {
+        if (ikstr_split_iter_carry(it, it->cur, (size_t)(hit - it->cur))) return -1;
+        it->cur = hit + sep_len;
+    } else {
+        if (avail && ikstr_split_iter_carry(it, it->cur, avail)) return -1;
+        it->cur = it->end;
+        if (!it->finished) return 0;
+        it->pending = 0;
+    }
+    *tok = ikstr_view_from(it->carry, ikstr_len(it->carry));
+    it->clear_carry = 1;
+    return 1;
+}
+
+void ikstr_split_iter_free(ikstr_split_iter *it) {
+    ikstr_free(it->carry);
+    it->carry = NULL;
+    it->clear_carry = 0;
+}
@@ -0,0 +1,1251 @@
+//
+// Created by ikryxxdev on 10/22/25.
+//
+
+#define _GNU_SOURCE // memmem, for comparison
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ikstr.h>
+#include <ikstr_alloc.h>
+#include <ikstr_arena.h>
+#include <ikstr_view.h>
+#include <ikstr_matcher.h>
+#include <ikstr_intern.h>
+#include <ikstr_map.h>
+#include <ikstr_rope.h>
+#include <ikstr_builder.h>
+#include <ikstr_file.h>
+#if !defined(_WIN32)
+#   include <fcntl.h>
+#   include <pthread.h>
+#   include <unistd.h>
+#endif
+
+/**
+ * Returns a monotonic-enough timestamp in seconds.
+ */
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * Prints one result line: operations per second and nanoseconds per operation.
+ */
+static void report(const char *name, double secs, size_t ops) {
+    printf("%-40s %10.3f ms  %8.1f ns/op  %10.2f Mop/s\n",
+           name, secs * 1e3, secs * 1e9 / (double)ops, (double)ops / secs / 1e6);
+}
+
+/*
+ * Keeps the optimizer from discarding results.
+ */
+static volatile size_t sink;
+
+#define REQUESTS 2000
+#define STRINGS_PER_REQUEST 500
+
+/**
+ * Simulates a per-request parsing path: many short strings created, appended
+ * to and released, using malloc/free for each of them.
+ */
+static void bench_malloc_path(void) {
+    ikstr strs[STRINGS_PER_REQUEST];
+    double t0 = now();
+
+    for (int r = 0; r < REQUESTS; ++r) {
+        for (int i = 0; i < STRINGS_PER_REQUEST; ++i) {
+            strs[i] = ikstr_new("header-name");
+            strs[i] = ikstr_concat(strs[i], ": some value");
+            sink += ikstr_len(strs[i]);
+        }
+        for (int i = 0; i < STRINGS_PER_REQUEST; ++i) ikstr_free(strs[i]);
+    }
+    report("request strings (malloc/free)", now() - t0, (size_t)REQUESTS * STRINGS_PER_REQUEST);
+}
+
+/**
+ * Same workload as bench_malloc_path, but every string comes from an arena
+ * that is reset once per request.
+ */
+static void bench_arena_path(void) {
+    ikstr_arena *arena = ikstr_arena_create(0);
+    ikstr strs[STRINGS_PER_REQUEST];
+    double t0 = now();
+
+    for (int r = 0; r < REQUESTS; ++r) {
+        for (int i = 0; i < STRINGS_PER_REQUEST; ++i) {
+            strs[i] = ikstr_arena_new(arena, "header-name");
+            strs[i] = ikstr_arena_concat(arena, strs[i], ": some value");
+            sink += ikstr_len(strs[i]);
+        }
+        ikstr_arena_reset(arena);
+    }
+    report("request strings (arena + reset)", now() - t0, (size_t)REQUESTS * STRINGS_PER_REQUEST);
+    ikstr_arena_destroy(arena);
+}
+
+/**
+ * Prints one throughput line in GB/s.
+ */
+static void report_bw(const char *name, double secs, size_t bytes) {
+    printf("%-40s %10.3f ms  %8.2f GB/s\n", name, secs * 1e3, (double)bytes / secs / 1e9);
+}
+
+/**
+ * Fills `buf` with lowercase tokens of about `density` bytes each, separated by `sep`.
+ */
+static void fill_tokens(char *buf, size_t len, size_t density, const char *sep, size_t sep_len) {
+    size_t i = 0;
+    srand(42);
+    while (i < len) {
+        size_t tok = 1 + (size_t)rand() % (2 * density);
+        for (size_t k = 0; k < tok && i < len; ++k) buf[i++] = (char)('a' + rand() % 26);
+        for (size_t k = 0; k < sep_len && i < len; ++k) buf[i++] = sep[k];
+    }
+}
+
+/**
+ * The byte-at-a-time separator scan ikstr_split_len used to do, for reference.
+ */
+static size_t count_tokens_bytewise(const char *s, size_t len, const char *sep, size_t sep_len) {
+    size_t count = 1;
+    for (size_t j = 0; j + sep_len <= len; ++j) {
+        if ((sep_len == 1 && s[j] == sep[0]) || memcmp(s + j, sep, sep_len) == 0) {
+            ++count;
+            j += sep_len - 1;
+        }
+    }
+    return count;
+}
+
+#define SPLIT_BYTES (64u * 1024 * 1024)
+
+/**
+ * Separator scan throughput for several separator lengths and token densities.
+ */
+static void bench_split_scan(void) {
+    static const char *seps[] = {",", "::", "|--|", "<<sep>>>"};
+    static const size_t densities[] = {8, 64, 512};
+    char *buf = malloc(SPLIT_BYTES);
+    char name[64];
+
+    if (NULL == buf) return;
+    for (size_t si = 0; si < sizeof(seps) / sizeof(seps[0]); ++si) {
+        size_t sep_len = strlen(seps[si]);
+        for (size_t di = 0; di < sizeof(densities) / sizeof(densities[0]); ++di) {
+            double t0;
+
+            fill_tokens(buf, SPLIT_BYTES, densities[di], seps[si], sep_len);
+
+            t0 = now();
+            sink += count_tokens_bytewise(buf, SPLIT_BYTES, seps[si], sep_len);
+            snprintf(name, sizeof(name), "bytewise    sep=%zu tok~%zu", sep_len, densities[di]);
+            report_bw(name, now() - t0, SPLIT_BYTES);
+
+            t0 = now();
+            sink += ikstr_split_view(buf, SPLIT_BYTES, seps[si], sep_len, NULL, 0);
+            snprintf(name, sizeof(name), "split_view  sep=%zu tok~%zu", sep_len, densities[di]);
+            report_bw(name, now() - t0, SPLIT_BYTES);
+        }
+    }
+    free(buf);
+}
+
+/**
+ * End-to-end ikstr_split_len (one ikstr per token) on a 64 MiB buffer.
+ */
+static void bench_split_len(void) {
+    char *buf = malloc(SPLIT_BYTES);
+    int count = 0;
+    double t0;
+
+    if (NULL == buf) return;
+    fill_tokens(buf, SPLIT_BYTES, 64, "::", 2);
+    t0 = now();
+    ikstr *tokens = ikstr_split_len(buf, SPLIT_BYTES, "::", 2, &count);
+    report_bw("split_len   sep=2 tok~64", now() - t0, SPLIT_BYTES);
+    ikstr_free_split_res(tokens, count);
+    free(buf);
+}
+
+/**
+ * ikstr_split_len against ikstr_split_len_batch on a 64 MiB buffer, for short
+ * and medium tokens: splitting, one pass over the tokens, and freeing.
+ */
+static void bench_split_batch(void) {
+    static const size_t densities[] = {8, 64};
+    char *buf = malloc(SPLIT_BYTES);
+    char name[64];
+
+    if (NULL == buf) return;
+    for (size_t di = 0; di < sizeof(densities) / sizeof(densities[0]); ++di) {
+        ikstr *tokens;
+        int count = 0;
+        double t0;
+
+        fill_tokens(buf, SPLIT_BYTES, densities[di], ",", 1);
+        for (int batch = 0; batch < 2; ++batch) {
+            const char *label = batch ? "split_len_batch" : "split_len      ";
+
+            t0 = now();
+            tokens = batch ? ikstr_split_len_batch(buf, SPLIT_BYTES, ",", 1, &count)
+                           : ikstr_split_len(buf, SPLIT_BYTES, ",", 1, &count);
+            snprintf(name, sizeof(name), "%s tok~%zu split", label, densities[di]);
+            report_bw(name, now() - t0, SPLIT_BYTES);
+
+            t0 = now();
+            for (int i = 0; i < count; ++i) sink += (unsigned char)tokens[i][ikstr_len(tokens[i]) / 2];
+            snprintf(name, sizeof(name), "%s tok~%zu walk", label, densities[di]);
+            report_bw(name, now() - t0, SPLIT_BYTES);
+
+            t0 = now();
+            if (batch) ikstr_free_batch(tokens, (size_t)count);
+            else ikstr_free_split_res(tokens, count);
+            snprintf(name, sizeof(name), "%s tok~%zu free", label, densities[di]);
+            report_bw(name, now() - t0, SPLIT_BYTES);
+        }
+    }
+    free(buf);
+}
+
+#define FIND_BYTES (64u * 1024 * 1024)
+
+/**
+ * Substring search throughput of ikstr_find_len against memmem and strstr,
+ * for absent needles of several lengths (full scan) and an adversarial case.
+ */
+static void bench_find(void) {
+    static const size_t needle_lens[] = {2, 4, 8, 16, 32, 64, 256};
+    char needle[257], name[64];
+    ikstr hay = ikstr_new_len(IKSTR_NO_INIT, FIND_BYTES);
+    double t0;
+
+    if (NULL == hay) return;
+    srand(7);
+    for (size_t i = 0; i < FIND_BYTES; ++i) hay[i] = (char)('a' + rand() % 26);
+
+    for (size_t ni = 0; ni < sizeof(needle_lens) / sizeof(needle_lens[0]); ++ni) {
+        size_t nl = needle_lens[ni];
+
+        // Starts like the haystack text but never occurs in it
+        for (size_t i = 0; i < nl - 1; ++i) needle[i] = (char)('a' + rand() % 26);
+        needle[nl - 1] = '!';
+        needle[nl] = '\0';
+
+        t0 = now();
+        sink += (size_t)ikstr_find_len(hay, needle, nl);
+        snprintf(name, sizeof(name), "ikstr_find  needle=%zu", nl);
+        report_bw(name, now() - t0, FIND_BYTES);
+#ifdef __GLIBC__
+        t0 = now();
+        sink += (size_t)memmem(hay, FIND_BYTES, needle, nl);
+        snprintf(name, sizeof(name), "memmem      needle=%zu", nl);
+        report_bw(name, now() - t0, FIND_BYTES);
+#endif
+        t0 = now();
+        sink += (size_t)strstr(hay, needle);
+        snprintf(name, sizeof(name), "strstr      needle=%zu", nl);
+        report_bw(name, now() - t0, FIND_BYTES);
+    }
+
+    // Adversarial: "aaaa...a" haystack, "aaa...ab" needle
+    memset(hay, 'a', FIND_BYTES);
+    memset(needle, 'a', 255);
+    needle[255] = 'b';
+    needle[256] = '\0';
+    t0 = now();
+    sink += (size_t)ikstr_find_len(hay, needle, 256);
+    report_bw("ikstr_find  adversarial needle=256", now() - t0, FIND_BYTES);
+    t0 = now();
+    sink += (size_t)strstr(hay, needle);
+    report_bw("strstr      adversarial needle=256", now() - t0, FIND_BYTES);
+
+    ikstr_free(hay);
+}
+
+#define MATCH_BYTES (8u * 1024 * 1024)
+#define MATCH_KEYWORDS 300
+
+static int count_match(void *ctx, size_t pattern_id, size_t offset) {
+    (void)pattern_id;
+    (void)offset;
+    ++*(size_t *)ctx;
+    return 0;
+}
+
+/**
+ * A few hundred keywords over a request-like text: one strstr pass per
+ * keyword against a single ikstr_matcher pass.
+ */
+static void bench_matcher(void) {
+    ikstr keywords[MATCH_KEYWORDS];
+    ikstr text = ikstr_new_len(IKSTR_NO_INIT, MATCH_BYTES);
+    size_t found = 0;
+    double t0;
+
+    if (NULL == text) return;
+    srand(11);
+    for (size_t i = 0; i < MATCH_BYTES; ++i) text[i] = (char)(rand() % 8 ? 'a' + rand() % 26 : ' ');
+    for (int k = 0; k < MATCH_KEYWORDS; ++k) {
+        char word[16];
+        int len = 4 + rand() % 9;
+        for (int i = 0; i < len; ++i) word[i] = (char)('a' + rand() % 26);
+        keywords[k] = ikstr_new_len(word, (size_t)len);
+        // Plant a few occurrences of every keyword
+        for (int n = 0; n < 20; ++n) memcpy(text + (size_t)rand() % (MATCH_BYTES - 16), word, (size_t)len);
+    }
+
+    t0 = now();
+    for (int k = 0; k < MATCH_KEYWORDS; ++k) {
+        const char *p = text;
+        while ((p = strstr(p, keywords[k])) != NULL) {
+            ++found;
+            ++p;
+        }
+    }
+    report_bw("strstr per keyword (300)", now() - t0, MATCH_BYTES);
+    sink += found;
+
+    t0 = now();
+    ikstr_matcher *m = ikstr_matcher_compile(keywords, MATCH_KEYWORDS);
+    report("matcher compile (300)", now() - t0, 1);
+    found = 0;
+    t0 = now();
+    ikstr_matcher_scan(m, text, count_match, &found);
+    report_bw("ikstr_matcher_scan (300)", now() - t0, MATCH_BYTES);
+    sink += found;
+
+    ikstr_matcher_free(m);
+    for (int k = 0; k < MATCH_KEYWORDS; ++k) ikstr_free(keywords[k]);
+    ikstr_free(text);
+}
+
+#define TRIM_PAD (16u * 1024 * 1024)
+
+/**
+ * Length left after trimming `set` from both ends the way ikstr_trim used to,
+ * with one strchr per byte.
+ */
+static size_t trim_strchr(const char *s, size_t len, const char *set) {
+    const char *start = s, *end = s + len;
+
+    while (start < end && strchr(set, *start)) start++;
+    while (end > start && strchr(set, end[-1])) end--;
+    return (size_t)(end - start);
+}
+
+/**
+ * Trimming large padding on both sides: per-byte strchr against ikstr_trim,
+ * for a small whitespace set and a larger set (bitset lookup only).
+ */
+static void bench_trim(void) {
+    static const char *sets[] = {" \t\r\n", " \t\r\n.,;:-_=+*#~|/\\"};
+    size_t len = 2 * TRIM_PAD + 5;
+    char name[64];
+    double t0;
+
+    for (size_t si = 0; si < sizeof(sets) / sizeof(sets[0]); ++si) {
+        size_t k = strlen(sets[si]);
+        ikstr s = ikstr_new_len(IKSTR_NO_INIT, len);
+
+        if (NULL == s) return;
+        for (size_t i = 0; i < TRIM_PAD; ++i) s[i] = s[len - 1 - i] = sets[si][i % k];
+        memcpy(s + TRIM_PAD, "hello", 5);
+
+        t0 = now();
+        sink += trim_strchr(s, len, sets[si]);
+        snprintf(name, sizeof(name), "strchr loop set=%zu", k);
+        report_bw(name, now() - t0, len);
+
+        t0 = now();
+        s = ikstr_trim(s, sets[si]);
+        snprintf(name, sizeof(name), "ikstr_trim  set=%zu", k);
+        report_bw(name, now() - t0, len);
+        sink += ikstr_len(s);
+
+        ikstr_free(s);
+    }
+}
+
+#define FMT_OPS 2000000
+
+/**
+ * Appending numbers: ikstr_concat_fmt against the dedicated numeric appends.
+ */
+static void bench_fmt(void) {
+    ikstr s = ikstr_empty();
+    double t0;
+
+    t0 = now();
+    for (int i = 0; i < FMT_OPS; ++i) {
+        ikstr_set_len(s, 0);
+        s = ikstr_concat_fmt(s, "%lld,%x,%.3f", i * 7919ll, (unsigned)i, i * 0.001);
+    }
+    report("concat_fmt  int,hex,double", now() - t0, FMT_OPS);
+    sink += ikstr_len(s);
+
+    t0 = now();
+    for (int i = 0; i < FMT_OPS; ++i) {
+        ikstr_set_len(s, 0);
+        s = ikstr_concat_int(s, i * 7919ll);
+        s = ikstr_concat_len(s, ",", 1);
+        s = ikstr_concat_hex(s, (unsigned)i);
+        s = ikstr_concat_len(s, ",", 1);
+        s = ikstr_concat_double(s, i * 0.001, 3);
+    }
+    report("concat_int/hex/double", now() - t0, FMT_OPS);
+    sink += ikstr_len(s);
+
+    ikstr_free(s);
+}
+
+#define JOIN_PARTS 100000
+
+/**
+ * Joining many short strings: repeated ikstr_concat (the former
+ * implementation) against the single-allocation ikstr_join_ikstr_n.
+ */
+static void bench_join(void) {
+    ikstr *parts = malloc(sizeof(ikstr) * JOIN_PARTS);
+    ikstr s;
+    double t0;
+
+    if (NULL == parts) return;
+    for (size_t i = 0; i < JOIN_PARTS; ++i) parts[i] = ikstr_new_fmt("field-%zu", i);
+
+    t0 = now();
+    s = ikstr_empty();
+    for (size_t i = 0; i < JOIN_PARTS; ++i) {
+        s = ikstr_concat_ikstr(s, parts[i]);
+        if (i < JOIN_PARTS - 1) s = ikstr_concat(s, ", ");
+    }
+    report("concat loop (per part)", now() - t0, JOIN_PARTS);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+
+    t0 = now();
+    s = ikstr_join_ikstr_n(JOIN_PARTS, parts, ", ");
+    report("ikstr_join_ikstr_n (per part)", now() - t0, JOIN_PARTS);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+
+    for (size_t i = 0; i < JOIN_PARTS; ++i) ikstr_free(parts[i]);
+    free(parts);
+}
+
+#define GROW_BYTES (128u * 1024 * 1024)
+#define GROW_CHUNK (64u * 1024)
+
+/**
+ * Appends 64 KiB chunks until the string holds 128 MiB.
+ */
+static void grow_run(const char *name, const ikstr_growth *g) {
+    static char chunk[GROW_CHUNK];
+    size_t reallocs = 0, cap;
+    ikstr s;
+    double t0;
+
+    ikstr_set_growth(g);
+    t0 = now();
+    s = ikstr_empty();
+    cap = ikstr_cap(s);
+    for (size_t n = 0; n < GROW_BYTES; n += GROW_CHUNK) {
+        s = ikstr_concat_len(s, chunk, GROW_CHUNK);
+        if (ikstr_cap(s) != cap) {
+            cap = ikstr_cap(s);
+            ++reallocs;
+        }
+    }
+    report_bw(name, now() - t0, GROW_BYTES);
+    printf("    %zu reallocations\n", reallocs);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+    ikstr_set_growth(NULL);
+}
+
+/**
+ * Building a large buffer under the default and the geometric growth policy.
+ */
+static void bench_grow(void) {
+    ikstr_growth geometric = {IKSTR_GROWTH_GEOMETRIC, 1.5, 1};
+
+    grow_run("default growth", NULL);
+    grow_run("geometric x1.5 + usable size", &geometric);
+}
+
+#define HDR_STRINGS 2000
+#define HDR_BYTES (100u * 1000)
+
+struct hdr_counts {
+    size_t allocs;
+    size_t moved; // bytes of the blocks released while the strings grew
+};
+
+static struct hdr_counts hdr_counts;
+
+static void *hdr_alloc(void *ctx, size_t size) {
+    (void)ctx;
+    ++hdr_counts.allocs;
+    return malloc(size);
+}
+
+static void *hdr_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void hdr_release(void *ctx, void *ptr) {
+    (void)ctx;
+    free(ptr);
+}
+
+static void hdr_release_sized(void *ctx, void *ptr, size_t size) {
+    (void)ctx;
+    hdr_counts.moved += size;
+    free(ptr);
+}
+
+/**
+ * Appends 64-byte chunks to many strings until each holds 100 KB, counting
+ * the header migrations (malloc + copy + free) that happen along the way.
+ */
+static void hdr_run(const char *name, int growable) {
+    static char chunk[64];
+    struct hdr_counts growth = {0, 0};
+    double t0;
+
+    t0 = now();
+    for (int i = 0; i < HDR_STRINGS; ++i) {
+        ikstr s = growable ? ikstr_new_growable("") : ikstr_empty();
+        size_t allocs = hdr_counts.allocs, moved = hdr_counts.moved;
+
+        for (size_t n = 0; n < HDR_BYTES; n += sizeof(chunk)) s = ikstr_concat_len(s, chunk, sizeof(chunk));
+        growth.allocs += hdr_counts.allocs - allocs;
+        growth.moved += hdr_counts.moved - moved;
+        sink += ikstr_len(s);
+        ikstr_free(s);
+    }
+    report(name, now() - t0, HDR_STRINGS);
+    printf("    %zu header migrations, replacing blocks of %zu bytes in total\n", growth.allocs, growth.moved);
+}
+
+/**
+ * Regular strings (8 -> 16 -> 32 bit headers) against ikstr_new_growable.
+ */
+static void bench_header(void) {
+    ikstr_allocator counting = {hdr_alloc, hdr_resize, hdr_release, hdr_release_sized, NULL, NULL};
+
+    ikstr_set_allocator(&counting);
+    hdr_run("ikstr_empty + appends", 0);
+    hdr_run("ikstr_new_growable + appends", 1);
+    ikstr_set_allocator(NULL);
+}
+
+#define SHARE_BYTES (1024u * 1024)
+#define SHARE_COPIES 1000
+
+/**
+ * Handing a 1 MiB payload to many consumers: ikstr_dup against ikstr_share.
+ */
+static void bench_share(void) {
+    ikstr *copies = malloc(sizeof(ikstr) * SHARE_COPIES);
+    ikstr s = ikstr_new_len(NULL, SHARE_BYTES);
+    double t0;
+
+    if (NULL == copies || NULL == s) return;
+
+    t0 = now();
+    for (int i = 0; i < SHARE_COPIES; ++i) copies[i] = ikstr_dup(s);
+    for (int i = 0; i < SHARE_COPIES; ++i) ikstr_free(copies[i]);
+    report("ikstr_dup + free (1 MiB)", now() - t0, SHARE_COPIES);
+
+    t0 = now();
+    for (int i = 0; i < SHARE_COPIES; ++i) copies[i] = ikstr_share(&s);
+    for (int i = 0; i < SHARE_COPIES; ++i) ikstr_release(copies[i]);
+    report("ikstr_share + release (1 MiB)", now() - t0, SHARE_COPIES);
+
+    ikstr_free(s);
+    free(copies);
+}
+
+#define INTERN_IDS 4000
+#define INTERN_OPS 20000000
+
+/**
+ * Equality of identifiers: ikstr_cmp on separate copies against a pointer
+ * compare on interned strings, plus the cost of interning itself.
+ */
+static void bench_intern(void) {
+    ikstr *copies = malloc(sizeof(ikstr) * INTERN_IDS);
+    ikstr *ids = malloc(sizeof(ikstr) * INTERN_IDS);
+    ikstr_intern_pool *pool = ikstr_intern_pool_create(0);
+    size_t eq = 0;
+    unsigned r = 1;
+    double t0;
+
+    if (NULL == copies || NULL == ids || NULL == pool) return;
+    for (int i = 0; i < INTERN_IDS; ++i) copies[i] = ikstr_new_fmt("identifier_%08d", i % (INTERN_IDS / 2));
+
+    t0 = now();
+    for (int i = 0; i < INTERN_IDS; ++i) ids[i] = ikstr_intern_len(pool, copies[i], ikstr_len(copies[i]));
+    report("ikstr_intern_len", now() - t0, INTERN_IDS);
+
+    t0 = now();
+    for (int i = 0; i < INTERN_OPS; ++i) {
+        r = r * 1103515245u + 12345u;
+        eq += ikstr_cmp(copies[r % INTERN_IDS], copies[(r >> 12) % INTERN_IDS]) == 0;
+    }
+    report("ikstr_cmp equality", now() - t0, INTERN_OPS);
+
+    t0 = now();
+    for (int i = 0; i < INTERN_OPS; ++i) {
+        r = r * 1103515245u + 12345u;
+        eq += ids[r % INTERN_IDS] == ids[(r >> 12) % INTERN_IDS];
+    }
+    report("interned pointer equality", now() - t0, INTERN_OPS);
+    sink += eq;
+
+    ikstr_intern_pool_destroy(pool);
+    for (int i = 0; i < INTERN_IDS; ++i) ikstr_free(copies[i]);
+    free(copies);
+    free(ids);
+}
+
+struct bench {
+    const char *name;
+    void (*fn)(void);
+};
+
+#define HASH_KEYS 4096
+#define HASH_ROUNDS 2000
+
+/**
+ * ikstr_hash_len throughput at several key sizes, and ikstr_hash on keys
+ * with and without a cached hash.
+ */
+static void bench_hash(void) {
+    static const size_t sizes[] = {8, 32, 256, 4096};
+    char *buf = malloc(1 << 20);
+    ikstr *keys = malloc(sizeof(ikstr) * HASH_KEYS);
+    uint64_t acc = 0;
+    double t0;
+
+    if (NULL == buf || NULL == keys) return;
+    fill_tokens(buf, 1 << 20, 8, ",", 1);
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+        size_t n = sizes[k], iters = ((size_t)256 << 20) / n;
+        char name[64];
+
+        t0 = now();
+        for (size_t i = 0; i < iters; ++i) acc += ikstr_hash_len(buf + (i * 64) % ((1 << 20) - n), n);
+        snprintf(name, sizeof(name), "ikstr_hash_len (%zu B)", n);
+        report_bw(name, now() - t0, iters * n);
+    }
+
+    for (int i = 0; i < HASH_KEYS; ++i) keys[i] = ikstr_new_len(buf + i * 200, 64);
+    t0 = now();
+    for (int r = 0; r < HASH_ROUNDS; ++r)
+        for (int i = 0; i < HASH_KEYS; ++i) acc += ikstr_hash(keys[i]);
+    report("ikstr_hash (64 B, uncached)", now() - t0, (size_t)HASH_ROUNDS * HASH_KEYS);
+
+    for (int i = 0; i < HASH_KEYS; ++i) keys[i] = ikstr_cache_hash(keys[i]);
+    t0 = now();
+    for (int r = 0; r < HASH_ROUNDS; ++r)
+        for (int i = 0; i < HASH_KEYS; ++i) acc += ikstr_hash(keys[i]);
+    report("ikstr_hash (64 B, cached)", now() - t0, (size_t)HASH_ROUNDS * HASH_KEYS);
+    sink += (size_t)acc;
+
+    for (int i = 0; i < HASH_KEYS; ++i) ikstr_free(keys[i]);
+    free(keys);
+    free(buf);
+}
+
+#define MAP_SMALL_KEYS 2000
+#define MAP_KEYS 200000
+#define MAP_LOOKUPS 4000000
+
+/*
+ * Chained hash table with one heap node per entry, as written by hand in
+ * most C code bases. Uses the same hash as ikstr_map.
+ */
+struct naive_node {
+    struct naive_node *next;
+    char *key;
+    size_t len;
+    void *value;
+};
+
+struct naive_map {
+    struct naive_node **buckets;
+    size_t nbuckets;
+    size_t count;
+};
+
+static struct naive_node *naive_find(const struct naive_map *m, const char *key, size_t len) {
+    struct naive_node *n = m->buckets[ikstr_hash_len(key, len) & (m->nbuckets - 1)];
+    for (; n; n = n->next) {
+        if (n->len == len && memcmp(n->key, key, len) == 0) return n;
+    }
+    return NULL;
+}
+
+static void naive_put(struct naive_map *m, const char *key, size_t len, void *value) {
+    struct naive_node *n = naive_find(m, key, len);
+    size_t b;
+
+    if (n) {
+        n->value = value;
+        return;
+    }
+    if (m->count == m->nbuckets) {
+        struct naive_node **nb = calloc(m->nbuckets * 2, sizeof(*nb));
+        for (size_t i = 0; i < m->nbuckets; ++i) {
+            while (m->buckets[i]) {
+                struct naive_node *e = m->buckets[i];
+                m->buckets[i] = e->next;
+                b = ikstr_hash_len(e->key, e->len) & (m->nbuckets * 2 - 1);
+                e->next = nb[b];
+                nb[b] = e;
+            }
+        }
+        free(m->buckets);
+        m->buckets = nb;
+        m->nbuckets *= 2;
+    }
+    n = malloc(sizeof(*n));
+    n->key = malloc(len);
+    memcpy(n->key, key, len);
+    n->len = len;
+    n->value = value;
+    b = ikstr_hash_len(key, len) & (m->nbuckets - 1);
+    n->next = m->buckets[b];
+    m->buckets[b] = n;
+    m->count++;
+}
+
+static void naive_free(struct naive_map *m) {
+    for (size_t i = 0; i < m->nbuckets; ++i) {
+        while (m->buckets[i]) {
+            struct naive_node *e = m->buckets[i];
+            m->buckets[i] = e->next;
+            free(e->key);
+            free(e);
+        }
+    }
+    free(m->buckets);
+}
+
+/*
+ * Inserts `nkeys` keys into both maps, then looks up present and absent keys
+ * given as char* + length in random order.
+ */
+static void bench_map_size(size_t nkeys) {
+    char (*keys)[24] = malloc(sizeof(*keys) * nkeys * 2);
+    size_t *lens = malloc(sizeof(size_t) * nkeys * 2);
+    struct naive_map nm = {calloc(16, sizeof(struct naive_node *)), 16, 0};
+    ikstr_map *m = ikstr_map_create(0);
+    size_t found = 0;
+    unsigned r = 1;
+    char name[64];
+    double t0;
+
+    if (NULL == keys || NULL == lens || NULL == nm.buckets || NULL == m) return;
+    // The second half of the keys is never inserted
+    for (size_t i = 0; i < nkeys * 2; ++i)
+        lens[i] = (size_t)snprintf(keys[i], sizeof(keys[i]), "user:%zu:session", i * 2654435761u % 100000000);
+
+    t0 = now();
+    for (size_t i = 0; i < nkeys; ++i) naive_put(&nm, keys[i], lens[i], (void *)i);
+    snprintf(name, sizeof(name), "chained map insert (%zu keys)", nkeys);
+    report(name, now() - t0, nkeys);
+
+    t0 = now();
+    for (size_t i = 0; i < nkeys; ++i) ikstr_map_put_len(m, keys[i], lens[i], (void *)i);
+    snprintf(name, sizeof(name), "ikstr_map_put_len (%zu keys)", nkeys);
+    report(name, now() - t0, nkeys);
+
+    t0 = now();
+    for (int i = 0; i < MAP_LOOKUPS; ++i) {
+        r = r * 1103515245u + 12345u;
+        found += naive_find(&nm, keys[r % nkeys], lens[r % nkeys]) != NULL;
+    }
+    snprintf(name, sizeof(name), "chained map hit (%zu keys)", nkeys);
+    report(name, now() - t0, MAP_LOOKUPS);
+
+    t0 = now();
+    for (int i = 0; i < MAP_LOOKUPS; ++i) {
+        r = r * 1103515245u + 12345u;
+        found += ikstr_map_find_len(m, keys[r % nkeys], lens[r % nkeys]) != NULL;
+    }
+    snprintf(name, sizeof(name), "ikstr_map_find_len hit (%zu keys)", nkeys);
+    report(name, now() - t0, MAP_LOOKUPS);
+
+    t0 = now();
+    for (int i = 0; i < MAP_LOOKUPS; ++i) {
+        size_t k = nkeys + (r = r * 1103515245u + 12345u) % nkeys;
+        found += naive_find(&nm, keys[k], lens[k]) != NULL;
+    }
+    snprintf(name, sizeof(name), "chained map miss (%zu keys)", nkeys);
+    report(name, now() - t0, MAP_LOOKUPS);
+
+    t0 = now();
+    for (int i = 0; i < MAP_LOOKUPS; ++i) {
+        size_t k = nkeys + (r = r * 1103515245u + 12345u) % nkeys;
+        found += ikstr_map_find_len(m, keys[k], lens[k]) != NULL;
+    }
+    snprintf(name, sizeof(name), "ikstr_map_find_len miss (%zu keys)", nkeys);
+    report(name, now() - t0, MAP_LOOKUPS);
+    sink += found;
+
+    ikstr_map_destroy(m);
+    naive_free(&nm);
+    free(lens);
+    free(keys);
+}
+
+/**
+ * ikstr_map against a naive chained map, with a table that fits in cache and
+ * one that does not.
+ */
+static void bench_map(void) {
+    bench_map_size(MAP_SMALL_KEYS);
+    bench_map_size(MAP_KEYS);
+}
+
+#define ROPE_BYTES ((size_t)8 << 20)
+#define ROPE_EDITS 2000
+
+/**
+ * Edits at random offsets of an 8 MiB text: a flat ikstr moving its tail
+ * with memmove against ikstr_rope, then the cost of flattening the rope.
+ */
+static void bench_rope(void) {
+    char *text = malloc(ROPE_BYTES);
+    ikstr flat;
+    ikstr_rope *r;
+    unsigned seed = 7;
+    double t0;
+
+    if (NULL == text) return;
+    fill_tokens(text, ROPE_BYTES, 8, " ", 1);
+    flat = ikstr_new_len(text, ROPE_BYTES);
+    r = ikstr_rope_new_len(text, ROPE_BYTES);
+    if (NULL == flat || NULL == r) return;
+
+    t0 = now();
+    for (int i = 0; i < ROPE_EDITS; ++i) {
+        size_t len = ikstr_len(flat), pos = (seed = seed * 1103515245u + 12345u) % len;
+        flat = ikstr_make_room_for(flat, 16);
+        memmove(flat + pos + 16, flat + pos, len - pos + 1);
+        memcpy(flat + pos, "inserted text 16", 16);
+        ikstr_inc_len(flat, 16);
+    }
+    report("flat insert 16 B (8 MiB)", now() - t0, ROPE_EDITS);
+
+    t0 = now();
+    for (int i = 0; i < ROPE_EDITS; ++i) {
+        size_t pos = (seed = seed * 1103515245u + 12345u) % ikstr_rope_len(r);
+        ikstr_rope_insert_len(r, pos, "inserted text 16", 16);
+    }
+    report("ikstr_rope_insert_len 16 B (8 MiB)", now() - t0, ROPE_EDITS);
+
+    t0 = now();
+    for (int i = 0; i < ROPE_EDITS; ++i) {
+        size_t len = ikstr_len(flat), pos = (seed = seed * 1103515245u + 12345u) % (len - 16);
+        memmove(flat + pos, flat + pos + 16, len - pos - 16 + 1);
+        ikstr_set_len(flat, len - 16);
+    }
+    report("flat erase 16 B (8 MiB)", now() - t0, ROPE_EDITS);
+
+    t0 = now();
+    for (int i = 0; i < ROPE_EDITS; ++i) {
+        size_t pos = (seed = seed * 1103515245u + 12345u) % (ikstr_rope_len(r) - 16);
+        ikstr_rope_erase(r, pos, 16);
+    }
+    report("ikstr_rope_erase 16 B (8 MiB)", now() - t0, ROPE_EDITS);
+
+    t0 = now();
+    ikstr_free(flat);
+    flat = ikstr_rope_flatten(r);
+    report_bw("ikstr_rope_flatten", now() - t0, ROPE_BYTES);
+    sink += ikstr_rope_chunks(r);
+
+    ikstr_free(flat);
+    ikstr_rope_free(r);
+    free(text);
+}
+
+#define BUILDER_ROWS 1000000
+#define BUILDER_PAGES 2000
+#define BUILDER_PAGE_ROWS 500
+
+/*
+ * Appends one table row, through ikstr_concat_* or through the builder.
+ */
+static ikstr row_concat(ikstr s, int i) {
+    s = ikstr_concat_len(s, "<tr><td>row ", 12);
+    s = ikstr_concat_int(s, i);
+    return ikstr_concat_len(s, "</td><td>some cell text</td></tr>\n", 34);
+}
+
+static void row_builder(ikstr_builder *b, int i) {
+    ikstr_builder_append_len(b, "<tr><td>row ", 12);
+    ikstr_builder_append_int(b, i);
+    ikstr_builder_append_len(b, "</td><td>some cell text</td></tr>\n", 34);
+}
+
+/**
+ * Building responses row by row: ikstr_concat_* on one growing string
+ * against ikstr_builder, for many 24 KB pages (reusing the builder) and one
+ * 52 MB document (finished into an ikstr or handed out as an iovec).
+ */
+static void bench_builder(void) {
+    struct iovec iov[256];
+    ikstr_builder b;
+    ikstr s;
+    double t0;
+
+    t0 = now();
+    for (int p = 0; p < BUILDER_PAGES; ++p) {
+        s = ikstr_empty();
+        for (int i = 0; i < BUILDER_PAGE_ROWS; ++i) s = row_concat(s, i);
+        sink += ikstr_len(s);
+        ikstr_free(s);
+    }
+    report("ikstr_concat (24 KB pages)", now() - t0, (size_t)BUILDER_PAGES * BUILDER_PAGE_ROWS);
+
+    t0 = now();
+    ikstr_builder_init(&b, 0);
+    for (int p = 0; p < BUILDER_PAGES; ++p) {
+        for (int i = 0; i < BUILDER_PAGE_ROWS; ++i) row_builder(&b, i);
+        s = ikstr_builder_finish(&b);
+        sink += ikstr_len(s);
+        ikstr_free(s);
+    }
+    ikstr_builder_free(&b);
+    report("ikstr_builder + finish (24 KB pages)", now() - t0, (size_t)BUILDER_PAGES * BUILDER_PAGE_ROWS);
+
+    t0 = now();
+    s = ikstr_empty();
+    for (int i = 0; i < BUILDER_ROWS; ++i) s = row_concat(s, i);
+    report("ikstr_concat (52 MB)", now() - t0, BUILDER_ROWS);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+
+    t0 = now();
+    for (int i = 0; i < BUILDER_ROWS; ++i) row_builder(&b, i);
+    sink += ikstr_builder_to_iovec(&b, iov, 256);
+    report("ikstr_builder + to_iovec (52 MB)", now() - t0, BUILDER_ROWS);
+
+    t0 = now();
+    s = ikstr_builder_finish(&b);
+    report("ikstr_builder_finish (52 MB)", now() - t0, BUILDER_ROWS);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+    ikstr_builder_free(&b);
+}
+
+#define MAPFILE_BYTES ((size_t)64 << 20)
+#define MAPFILE_PATH "ikstr_bench_mapfile.tmp"
+
+/**
+ * Loading a 64 MiB file (from the page cache) and counting its lines:
+ * fread into a buffer + ikstr_new_len against ikstr_map_file.
+ */
+static void bench_mapfile(void) {
+    char *buf = malloc(MAPFILE_BYTES);
+    FILE *f;
+    ikstr s;
+    double t0;
+
+    if (NULL == buf) return;
+    fill_tokens(buf, MAPFILE_BYTES, 40, "\n", 1);
+    f = fopen(MAPFILE_PATH, "wb");
+    if (NULL == f) return;
+    fwrite(buf, 1, MAPFILE_BYTES, f);
+    fclose(f);
+
+    t0 = now();
+    f = fopen(MAPFILE_PATH, "rb");
+    if (fread(buf, 1, MAPFILE_BYTES, f) != MAPFILE_BYTES) return;
+    fclose(f);
+    s = ikstr_new_len(buf, MAPFILE_BYTES);
+    report_bw("fread + ikstr_new_len", now() - t0, MAPFILE_BYTES);
+    t0 = now();
+    sink += ikstr_count(s, "\n");
+    report_bw("  + count lines", now() - t0, MAPFILE_BYTES);
+    ikstr_free(s);
+
+    t0 = now();
+    s = ikstr_map_file(MAPFILE_PATH);
+    report_bw("ikstr_map_file", now() - t0, MAPFILE_BYTES);
+    t0 = now();
+    sink += ikstr_count(s, "\n");
+    report_bw("  + count lines", now() - t0, MAPFILE_BYTES);
+    t0 = now();
+    ikstr_free(s);
+    report_bw("  + ikstr_free (munmap)", now() - t0, MAPFILE_BYTES);
+
+    remove(MAPFILE_PATH);
+    free(buf);
+}
+
+#if !defined(_WIN32)
+#define IO_BYTES ((size_t)64 << 20)
+#define IO_PATH "ikstr_bench_io.tmp"
+#define IO_PARTS 64
+#define IO_BATCHES 20000
+
+/**
+ * Reading a 64 MiB file (from the page cache) through a stack buffer +
+ * ikstr_concat_len against ikstr_read_fd into the tail and ikstr_read_file,
+ * then writing batches of 64 short strings to /dev/null one write per string,
+ * joined into one buffer, or with ikstr_writev_many.
+ */
+static void bench_io(void) {
+    char *buf = malloc(IO_BYTES);
+    char chunk[IKSTR_IO_CHUNK];
+    ikstr parts[IO_PARTS], s;
+    FILE *f;
+    ssize_t n;
+    double t0;
+    int fd;
+
+    if (NULL == buf) return;
+    fill_tokens(buf, IO_BYTES, 40, "\n", 1);
+    f = fopen(IO_PATH, "wb");
+    if (NULL == f) return;
+    fwrite(buf, 1, IO_BYTES, f);
+    fclose(f);
+    free(buf);
+
+    t0 = now();
+    fd = open(IO_PATH, O_RDONLY);
+    s = ikstr_empty();
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) s = ikstr_concat_len(s, chunk, (size_t)n);
+    close(fd);
+    report_bw("read + ikstr_concat_len", now() - t0, IO_BYTES);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+
+    t0 = now();
+    fd = open(IO_PATH, O_RDONLY);
+    s = ikstr_empty();
+    while (ikstr_read_fd(&s, fd, 0) > 0);
+    close(fd);
+    report_bw("ikstr_read_fd", now() - t0, IO_BYTES);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+
+    t0 = now();
+    s = ikstr_read_file(IO_PATH);
+    report_bw("ikstr_read_file", now() - t0, IO_BYTES);
+    sink += ikstr_len(s);
+    ikstr_free(s);
+    remove(IO_PATH);
+
+    fd = open("/dev/null", O_WRONLY);
+    if (fd < 0) return;
+    for (int i = 0; i < IO_PARTS; ++i) parts[i] = ikstr_new_fmt("header-%02d: value of part %d\r\n", i, i * 7);
+
+    t0 = now();
+    for (int b = 0; b < IO_BATCHES; ++b) {
+        for (int i = 0; i < IO_PARTS; ++i) sink += (size_t)ikstr_write_fd(fd, parts[i]);
+    }
+    report("ikstr_write_fd per string (batch of 64)", now() - t0, IO_BATCHES);
+
+    s = ikstr_empty();
+    t0 = now();
+    for (int b = 0; b < IO_BATCHES; ++b) {
+        ikstr_set_len(s, 0);
+        for (int i = 0; i < IO_PARTS; ++i) s = ikstr_concat_ikstr(s, parts[i]);
+        sink += (size_t)ikstr_write_fd(fd, s);
+    }
+    report("ikstr_concat + ikstr_write_fd (batch of 64)", now() - t0, IO_BATCHES);
+    ikstr_free(s);
+
+    t0 = now();
+    for (int b = 0; b < IO_BATCHES; ++b) sink += (size_t)ikstr_writev_many(fd, parts, IO_PARTS);
+    report("ikstr_writev_many (batch of 64)", now() - t0, IO_BATCHES);
+
+    for (int i = 0; i < IO_PARTS; ++i) ikstr_free(parts[i]);
+    close(fd);
+}
+
+#define LINES_BLOCK ((size_t)64 << 20)
+#define LINES_BLOCKS 32
+#define LINES_PATH "ikstr_bench_lines.tmp"
+
+/**
+ * Reading a 2 GiB file of ~40-byte records (from the page cache): blocks of
+ * 1 MiB split with ikstr_split_len, one ikstr per line, against
+ * ikstr_line_reader returning views.
+ */
+static void bench_lines(void) {
+    const size_t bytes = LINES_BLOCK * LINES_BLOCKS;
+    char *buf = malloc(LINES_BLOCK);
+    ikstr_line_reader lr;
+    ikstr_view line;
+    ikstr block;
+    size_t lines = 0;
+    double t0;
+    int fd;
+
+    if (NULL == buf) return;
+    fill_tokens(buf, LINES_BLOCK, 40, "\n", 1);
+    fd = open(LINES_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    for (int i = 0; i < LINES_BLOCKS; ++i) {
+        if (write(fd, buf, LINES_BLOCK) != (ssize_t)LINES_BLOCK) return;
+    }
+    close(fd);
+    free(buf);
+
+    t0 = now();
+    fd = open(LINES_PATH, O_RDONLY);
+    block = ikstr_empty();
+    for (;;) {
+        ssize_t n = ikstr_read_fd(&block, fd, (size_t)1 << 20);
+        ssize_t last = n > 0 ? ikstr_rfind_len(block, "\n", 1) : (ssize_t)ikstr_len(block);
+        ikstr *tokens;
+        int count = 0;
+
+        if (n < 0 || last < 0) continue;
+        tokens = ikstr_split_len(block, last, "\n", 1, &count);
+        for (int i = 0; i < count; ++i) sink += ikstr_len(tokens[i]);
+        lines += (size_t)count;
+        ikstr_free_split_res(tokens, count);
+        if (n == 0) break;
+        block = ikstr_range(block, last + 1, -1); // carry the unfinished line
+    }
+    close(fd);
+    ikstr_free(block);
+    report_bw("read_fd + ikstr_split_len per block", now() - t0, bytes);
+
+    t0 = now();
+    fd = open(LINES_PATH, O_RDONLY);
+    ikstr_line_reader_init(&lr, fd);
+    while (ikstr_line_reader_next(&lr, &line) == 1) {
+        sink += line.len;
+        --lines;
+    }
+    ikstr_line_reader_free(&lr);
+    close(fd);
+    report_bw("ikstr_line_reader", now() - t0, bytes);
+    sink += lines;
+
+    remove(LINES_PATH);
+}
+#endif
+
+#if !defined(_WIN32)
+#define TCACHE_OPS 4000000
+#define TCACHE_LIVE 256
+#define TCACHE_MAX_THREADS 8
+
+/**
+ * Worker of bench_tcache: keeps TCACHE_LIVE short strings alive and replaces
+ * a random one per operation.
+ */
+static void *tcache_worker(void *arg) {
+    ikstr live[TCACHE_LIVE];
+    unsigned x = (unsigned)(size_t)arg * 2654435761u + 1;
+    size_t acc = 0;
+
+    for (int i = 0; i < TCACHE_LIVE; ++i) live[i] = ikstr_new_len(IKSTR_NO_INIT, (size_t)i % 64);
+    for (int i = 0; i < TCACHE_OPS; ++i) {
+        unsigned k;
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        k = x % TCACHE_LIVE;
+        ikstr_free(live[k]);
+        live[k] = ikstr_new_len(IKSTR_NO_INIT, x >> 26); // 0..63 bytes
+        acc += ikstr_len(live[k]);
+    }
+    for (int i = 0; i < TCACHE_LIVE; ++i) ikstr_free(live[i]);
+    return (void *)acc;
+}
+
+static double tcache_run(int threads) {
+    pthread_t t[TCACHE_MAX_THREADS];
+    double t0 = now();
+
+    for (int i = 0; i < threads; ++i) pthread_create(&t[i], NULL, tcache_worker, (void *)(size_t)i);
+    for (int i = 0; i < threads; ++i) {
+        void *r;
+        pthread_join(t[i], &r);
+        sink += (size_t)r;
+    }
+    return now() - t0;
+}
+
+/**
+ * ikstr_new_len/ikstr_free churn of short strings on 1, 4 and 8 threads,
+ * with the libc allocator against the thread cache in front of it.
+ */
+static void bench_tcache(void) {
+    static const int threads[] = {1, 4, 8};
+    const ikstr_allocator *tc = ikstr_tcache_init(NULL);
+    ikstr_tcache_stats st;
+    char name[64];
+
+    if (NULL == tc) return;
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+        snprintf(name, sizeof(name), "libc malloc,  %d thread(s)", threads[i]);
+        report(name, tcache_run(threads[i]), (size_t)TCACHE_OPS * threads[i]);
+
+        ikstr_set_allocator(tc);
+        snprintf(name, sizeof(name), "ikstr_tcache, %d thread(s)", threads[i]);
+        report(name, tcache_run(threads[i]), (size_t)TCACHE_OPS * threads[i]);
+        ikstr_set_allocator(NULL);
+    }
+    ikstr_tcache_get_stats(&st);
+    printf("tcache hit rate: %.1f%%\n", 100.0 * (double)st.hits / (double)(st.hits + st.misses));
+}
+#endif
+
+static const struct bench benches[] = {
+    {"alloc", bench_malloc_path},
+    {"alloc", bench_arena_path},
+    {"split", bench_split_scan},
+    {"split", bench_split_len},
+    {"split", bench_split_batch},
+    {"find", bench_find},
+    {"matcher", bench_matcher},
+    {"trim", bench_trim},
+    {"fmt", bench_fmt},
+    {"join", bench_join},
+    {"grow", bench_grow},
+    {"header", bench_header},
+    {"share", bench_share},
+    {"intern", bench_intern},
+    {"hash", bench_hash},
+    {"map", bench_map},
+    {"rope", bench_rope},
+    {"builder", bench_builder},
+    {"mapfile", bench_mapfile},
+#if !defined(_WIN32)
+    {"io", bench_io},
+    {"lines", bench_lines},
+    {"tcache", bench_tcache},
+#endif
+};
+
+/**
+ * Runs all benchmarks, or only those whose group name matches argv[1].
+ */
+int main(int argc, char **argv) {
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); ++i) {
+        if (argc > 1 && strcmp(argv[1], benches[i].name) != 0) continue;
+        benches[i].fn();
+    }
+    return 0;
+}
@@ -5,7 +5,21 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <ikstr.h>
+#include <ikstr_arena.h>
+#include <ikstr_alloc.h>
+#include <ikstr_view.h>
+#include <ikstr_matcher.h>
+#include <ikstr_intern.h>
+#include <ikstr_map.h>
+#include <ikstr_rope.h>
+#include <ikstr_builder.h>
+#include <ikstr_file.h>
+#include <ikstr_stats.h>
 #include <string.h>
+#if !defined(_WIN32)
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
 
 /**
  * Helper to print an ikstr with its length and capacity.
@@ -120,22 +134,41 @@ void ex_copy_variants(void) {
 }
 
 /**
- * Demonstrates ikstr_concat_fmt, ikstr_concat_vfmt (indirect), and ikstr_new_fmt.
+ * Demonstrates ikstr_concat_fmt, ikstr_concat_vfmt (indirect), ikstr_new_fmt and
+ * the numeric appends (ikstr_concat_int/uint/hex/double).
  */
 void ex_formatting(void) {
     ikstr s = ikstr_new("Count: ");
     s = ikstr_concat_fmt(s, "%d + %d = %d", 2, 3, 5);
     print_ikstr("concat_fmt", s);
 
+    // Arguments may point into the string being appended to
+    ikstr e = ikstr_new("echo");
+    e = ikstr_concat_fmt(e, "|%s|%s", e, e);
+    print_ikstr("self concat_fmt", e);
+
     ikstr t = ikstr_new_fmt("Pi approx: %.2f, hex: 0x%X", 3.14159, 48879);
     print_ikstr("new_fmt", t);
 
+    // Numeric appends without printf
+    ikstr u = ikstr_new("id=");
+    u = ikstr_concat_int(u, -42);
+    u = ikstr_concat(u, " size=");
+    u = ikstr_concat_uint(u, 18446744073709551615ull);
+    u = ikstr_concat(u, " addr=0x");
+    u = ikstr_concat_hex(u, 0xbeefu);
+    u = ikstr_concat(u, " ratio=");
+    u = ikstr_concat_double(u, -3.14159, 3);
+    print_ikstr("numeric", u);
+
     ikstr_free(s);
+    ikstr_free(e);
     ikstr_free(t);
+    ikstr_free(u);
 }
 
 /**
- * Demonstrates ikstr_trim.
+ * Demonstrates ikstr_trim, ikstr_ltrim/ikstr_rtrim and ikstr_charset.
  */
 void ex_trim(void) {
     ikstr s = ikstr_new(" \t\n--hello world--\n ");
@@ -145,6 +178,258 @@ void ex_trim(void) {
     print_ikstr("after trim", s);
 
     ikstr_free(s);
+
+    // One-sided trims with a precompiled set, reused for both calls
+    ikstr_charset pad;
+    ikstr_charset_init(&pad, " .");
+
+    s = ikstr_new("...  padded  ...");
+    s = ikstr_rtrim_set(s, &pad);
+    print_ikstr("after rtrim", s);
+    s = ikstr_ltrim_set(s, &pad);
+    print_ikstr("after ltrim", s);
+
+    ikstr_free(s);
+}
+
+/**
+ * Demonstrates shared strings: ikstr_share, ikstr_refcount and copy-on-write.
+ */
+void ex_shared(void) {
+    ikstr a = ikstr_new("shared payload");
+    ikstr b = ikstr_share(&a); // a moves once, b is the same pointer
+    ikstr c = ikstr_share(&a); // O(1) from now on
+
+    printf("same buffer: %d, refcount: %zu\n", a == b && b == c, ikstr_refcount(a));
+
+    // Modifying one reference gives it a private copy
+    c = ikstr_concat(c, " (edited)");
+    print_ikstr("a", a);
+    print_ikstr("c", c);
+    printf("refcount after copy-on-write: %zu\n", ikstr_refcount(a));
+
+    ikstr_free(a);
+    ikstr_release(b);
+    ikstr_free(c);
+}
+
+/**
+ * Demonstrates ikstr_intern_pool: equal content, equal pointers.
+ */
+void ex_intern(void) {
+    ikstr_intern_pool *pool = ikstr_intern_pool_create(0);
+    const char *words[] = {"GET", "POST", "GET", "PUT", "POST", "GET"};
+    ikstr ids[6];
+
+    for (int i = 0; i < 6; ++i) ids[i] = ikstr_intern(pool, words[i]);
+    printf("distinct: %zu\n", ikstr_intern_pool_count(pool));
+    printf("ids[0] == ids[2]: %d, ids[0] == ids[1]: %d\n", ids[0] == ids[2], ids[0] == ids[1]);
+    printf("find PUT: %d, find DELETE: %d\n",
+           ikstr_intern_find_len(pool, "PUT", 3) == ids[3], ikstr_intern_find_len(pool, "DELETE", 6) != NULL);
+
+    // Keep one beyond the pool
+    ikstr kept = ikstr_retain(ids[1]);
+    ikstr_intern_pool_destroy(pool);
+    print_ikstr("kept", kept);
+    ikstr_free(kept);
+}
+
+/**
+ * Demonstrates ikstr_hash and the cached hash.
+ */
+void ex_hash(void) {
+    ikstr s = ikstr_new("session:4711");
+
+    printf("hash matches bytes: %d\n", ikstr_hash(s) == ikstr_hash_len("session:4711", 12));
+
+    s = ikstr_cache_hash(s); // moves once, later calls read the cache
+    printf("cached: %d\n", (s[-1] & IKSTR_FLAG_HASHED) != 0);
+
+    // Any modification drops the cached value
+    s = ikstr_concat(s, "!");
+    printf("cached after concat: %d\n", (s[-1] & IKSTR_FLAG_HASHED) != 0);
+    printf("hash matches new bytes: %d\n", ikstr_hash(s) == ikstr_hash_len("session:4711!", 13));
+
+    ikstr_free(s);
+}
+
+/**
+ * Demonstrates ikstr_map: counting words, lookups without building an ikstr.
+ */
+void ex_map(void) {
+    ikstr_map *m = ikstr_map_create(0);
+    const char *text = "the cat saw the dog and the dog saw the cat";
+    ikstr_view words[16];
+    size_t n = ikstr_split_view(text, strlen(text), " ", 1, words, 16);
+    size_t pos = 0;
+    ikstr key;
+    void *value;
+
+    for (size_t i = 0; i < n; ++i) {
+        void **count = ikstr_map_find_len(m, words[i].ptr, words[i].len);
+        if (count) *count = (void *)((uintptr_t)*count + 1);
+        else ikstr_map_put_len(m, words[i].ptr, words[i].len, (void *)(uintptr_t)1);
+    }
+    printf("distinct words: %zu\n", ikstr_map_count(m));
+    printf("\"the\": %zu\n", (size_t)(uintptr_t)*ikstr_map_find_len(m, "the", 3));
+
+    ikstr_map_remove_len(m, "and", 3, NULL);
+    printf("\"and\" after remove: %s\n", ikstr_map_find_len(m, "and", 3) ? "found" : "missing");
+
+    while (ikstr_map_next(m, &pos, &key, &value)) {
+        if ((uintptr_t)value > 1) printf("%s x%zu\n", key, (size_t)(uintptr_t)value);
+    }
+    ikstr_map_destroy(m);
+}
+
+/**
+ * Demonstrates ikstr_rope: edits in the middle, substrings, chunk iteration.
+ */
+void ex_rope(void) {
+    ikstr_rope *r = ikstr_rope_new_len("The fox jumps over the dog.", 27);
+    ikstr_rope *sub;
+    ikstr_rope_iter it;
+    const char *chunk;
+    size_t len;
+    ikstr flat;
+
+    ikstr_rope_insert_len(r, 4, "quick brown ", 12);
+    ikstr_rope_insert_len(r, 35, "lazy ", 5);
+    ikstr_rope_erase(r, 0, 4);
+    flat = ikstr_rope_flatten(r);
+    print_ikstr("rope", flat);
+    ikstr_free(flat);
+
+    sub = ikstr_rope_substr(r, 6, 9); // shares the chunks
+    flat = ikstr_rope_flatten(sub);
+    print_ikstr("substr", flat);
+    ikstr_free(flat);
+
+    printf("chunks:");
+    ikstr_rope_iter_init(&it, r);
+    while (ikstr_rope_iter_next(&it, &chunk, &len)) printf(" [%.*s]", (int)len, chunk);
+    printf("\n");
+
+    ikstr_rope_free(sub);
+    ikstr_rope_free(r);
+}
+
+/**
+ * Demonstrates ikstr_builder: chunked appends, one-shot finish.
+ */
+void ex_builder(void) {
+    ikstr_builder b;
+    struct iovec iov[8];
+    size_t n;
+    ikstr s;
+
+    ikstr_builder_init(&b, 16); // tiny chunks to show the chunk list
+    ikstr_builder_append(&b, "HTTP/1.1 200 OK\r\n");
+    ikstr_builder_append(&b, "Content-Length: ");
+    ikstr_builder_append_int(&b, 1234);
+    ikstr_builder_append_fmt(&b, "\r\nX-Request: %s-%03d\r\n", "req", 7);
+
+    n = ikstr_builder_to_iovec(&b, iov, 8);
+    printf("builder len=%zu, iovec entries=%zu\n", ikstr_builder_len(&b), n);
+
+    s = ikstr_builder_finish(&b);
+    print_ikstr("finished", s);
+    ikstr_free(s);
+    ikstr_builder_free(&b);
+}
+
+/**
+ * Demonstrates ikstr_map_file: a file read without copying, promoted to a
+ * heap string when modified.
+ */
+void ex_map_file(void) {
+    const char *path = "ikstr_example.tmp";
+    FILE *f = fopen(path, "wb");
+    ikstr s;
+
+    if (NULL == f) return;
+    fputs("host=example.org\nport=8080\n", f);
+    fclose(f);
+
+    s = ikstr_map_file(path);
+    if (NULL == s) return;
+    printf("mapped len=%zu, find(\"port\")=%zd\n", ikstr_len(s), ikstr_find(s, "port"));
+
+    s = ikstr_concat(s, "debug=1\n"); // copy-on-write: the file is not touched
+    print_ikstr("promoted", s);
+    ikstr_free(s);
+    remove(path);
+}
+
+/**
+ * Demonstrates ikstr_writev_many, ikstr_read_fd and ikstr_read_file.
+ * - Writes a response through a pipe as separate strings, reads it back in
+ *   small pieces straight into an ikstr, then loads a whole file.
+ */
+void ex_io(void) {
+    const char *path = "ikstr_example.tmp";
+    ikstr s;
+#if !defined(_WIN32)
+    ikstr parts[3];
+    int fds[2];
+    ssize_t n;
+    int reads = 0;
+
+    if (pipe(fds) != 0) return;
+    parts[0] = ikstr_new("HTTP/1.1 200 OK\r\n");
+    parts[1] = ikstr_new("Content-Length: 5\r\n\r\n");
+    parts[2] = ikstr_new("hello");
+    printf("writev_many wrote %zd bytes\n", ikstr_writev_many(fds[1], parts, 3));
+    close(fds[1]);
+
+    s = ikstr_empty();
+    while ((n = ikstr_read_fd(&s, fds[0], 16)) > 0) ++reads;
+    close(fds[0]);
+    printf("read_fd: %zu bytes in %d reads, body at %zd\n", ikstr_len(s), reads, ikstr_find(s, "hello"));
+
+    fds[1] = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fds[1] >= 0) {
+        printf("write_fd wrote %zd bytes\n", ikstr_write_fd(fds[1], s));
+        close(fds[1]);
+    }
+    ikstr_free(s);
+    for (int i = 0; i < 3; ++i) ikstr_free(parts[i]);
+#else
+    FILE *f = fopen(path, "wb");
+    if (NULL == f) return;
+    fputs("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello", f);
+    fclose(f);
+#endif
+
+    s = ikstr_read_file(path);
+    if (s) printf("read_file len=%zu, cap=%zu\n", ikstr_len(s), ikstr_cap(s));
+    ikstr_free(s);
+    remove(path);
+}
+
+/**
+ * Demonstrates ikstr_line_reader.
+ * - Reads records from a pipe as views into the reader's buffer; the last
+ *   record has no terminating newline.
+ */
+void ex_line_reader(void) {
+#if !defined(_WIN32)
+    const char input[] = "id=1 ok\nid=2 retry\n\nid=3 ok";
+    ikstr_line_reader lr;
+    ikstr_view line;
+    int fds[2];
+
+    if (pipe(fds) != 0) return;
+    if (write(fds[1], input, sizeof(input) - 1) < 0) return;
+    close(fds[1]);
+
+    ikstr_line_reader_init(&lr, fds[0]);
+    while (ikstr_line_reader_next(&lr, &line) == 1) {
+        printf("line: \"%.*s\"\n", (int)line.len, line.ptr);
+    }
+    ikstr_line_reader_free(&lr);
+    close(fds[0]);
+#endif
 }
 
 /**
@@ -154,13 +439,13 @@ void ex_range(void) {
     ikstr s = ikstr_new("0123456789");
     print_ikstr("original", s);
 
-    ikstr_range(s, 2, 6); // keep "23456"
+    s = ikstr_range(s, 2, 6); // keep "23456"
     print_ikstr("range(2,6)", s);
 
-    ikstr_range(s, -3, -1); // from end: last 3 -> "456" -> then range on current -> becomes "456"
+    s = ikstr_range(s, -3, -1); // from end: last 3 -> "456" -> then range on current -> becomes "456"
     print_ikstr("range(-3,-1)", s);
 
-    ikstr_range(s, 5, 2); // invalid -> empty
+    s = ikstr_range(s, 5, 2); // invalid -> empty
     print_ikstr("range(5,2)", s);
 
     ikstr_free(s);
@@ -183,6 +468,53 @@ void ex_compare(void) {
     ikstr_free(c);
 }
 
+/**
+ * Demonstrates ikstr_find, ikstr_rfind, ikstr_find_char and ikstr_count.
+ */
+void ex_find(void) {
+    ikstr s = ikstr_new_len("key=a;key=b;\0key=c", 19); // embedded '\0'
+
+    printf("find(\"key\") = %zd\n", ikstr_find(s, "key"));
+    printf("rfind(\"key\") = %zd\n", ikstr_rfind(s, "key")); // past the '\0', unlike strstr
+    printf("find_char('=') = %zd\n", ikstr_find_char(s, '='));
+    printf("find_char('\\0') = %zd\n", ikstr_find_char(s, '\0'));
+    printf("count(\"key=\") = %zu\n", ikstr_count(s, "key="));
+    printf("find(\"nope\") = %zd\n", ikstr_find(s, "nope"));
+
+    ikstr_free(s);
+}
+
+static int print_match(void *ctx, size_t pattern_id, size_t offset) {
+    ikstr *needles = ctx;
+    printf("match \"%s\" at %zu\n", needles[pattern_id], offset);
+    return 0;
+}
+
+/**
+ * Demonstrates ikstr_matcher: several keywords found in a single pass.
+ */
+void ex_matcher(void) {
+    ikstr needles[4];
+    needles[0] = ikstr_new("he");
+    needles[1] = ikstr_new("she");
+    needles[2] = ikstr_new("his");
+    needles[3] = ikstr_new("hers");
+
+    ikstr_matcher *m = ikstr_matcher_compile(needles, 4);
+    ikstr text = ikstr_new("ushers and his");
+    size_t n = ikstr_matcher_scan(m, text, print_match, needles);
+    printf("matcher found %zu matches\n", n);
+
+    ikstr_match_iter it;
+    size_t id, off;
+    ikstr_match_iter_init(&it, m, text, ikstr_len(text));
+    while (ikstr_match_iter_next(&it, &id, &off)) printf("iter match %zu at %zu\n", id, off);
+
+    ikstr_free(text);
+    ikstr_matcher_free(m);
+    for (int i = 0; i < 4; ++i) ikstr_free(needles[i]);
+}
+
 /**
  * Demonstrates ikstr_split_len, ikstr_split, and ikstr_free_split_res.
  */
@@ -208,6 +540,29 @@ void ex_split_and_free(void) {
     ikstr_free_split_res(t2, count2);
 }
 
+/**
+ * Demonstrates ikstr_new_batch, ikstr_split_len_batch and ikstr_free_batch.
+ * - The tokens share one allocation; growing one moves it to the heap.
+ */
+void ex_batch(void) {
+    const char *text = "GET,/index.html,HTTP/1.1";
+    ikstr_view names[] = {ikstr_view_cstr("host"), ikstr_view_cstr("port")};
+    ikstr *table = ikstr_new_batch(names, 2);
+    int count = 0;
+    ikstr *tokens;
+
+    if (NULL == table) return;
+    printf("batch: %s %s, bytes between them: %td\n", table[0], table[1], table[1] - table[0]);
+    ikstr_free_batch(table, 2);
+
+    tokens = ikstr_split_len_batch(text, (ssize_t)strlen(text), ",", 1, &count);
+    printf("split_len_batch count=%d\n", count);
+    for (int i = 0; i < count; ++i) print_ikstr("token", tokens[i]);
+    tokens[1] = ikstr_concat(tokens[1], "?page=2");
+    print_ikstr("grown token", tokens[1]);
+    ikstr_free_batch(tokens, (size_t)count);
+}
+
 /**
  * Demonstrates ikstr_join with C strings.
  */
@@ -219,7 +574,7 @@ void ex_join_cstr(void) {
 }
 
 /**
- * Demonstrates ikstr_join_ikstr with ikstr array.
+ * Demonstrates ikstr_join_ikstr and ikstr_join_ikstr_into with ikstr array.
  */
 void ex_join_ikstr(void) {
     ikstr parts[4];
@@ -231,8 +586,20 @@ void ex_join_ikstr(void) {
     ikstr j = ikstr_join_ikstr(4, parts, "/");
     print_ikstr("join ikstr", j);
 
+    // Append a join to an existing string
+    ikstr k = ikstr_new("colors: ");
+    k = ikstr_join_ikstr_into(k, 3, parts, ", ");
+    print_ikstr("join into", k);
+
+    // The appended-to string may itself be one of the parts
+    ikstr r = ikstr_new("ab");
+    r = ikstr_join_ikstr_into(r, 3, (ikstr[]){r, r, r}, ",");
+    print_ikstr("join into itself", r);
+
     for (int i = 0; i < 4; ++i) ikstr_free(parts[i]);
     ikstr_free(j);
+    ikstr_free(k);
+    ikstr_free(r);
 }
 
 /**
@@ -254,6 +621,249 @@ void ex_make_room_for(void) {
     ikstr_free(s);
 }
 
+/**
+ * Demonstrates the growth policy, ikstr_reserve, ikstr_shrink_to_fit and
+ * ikstr_new_growable.
+ */
+void ex_growth(void) {
+    ikstr_growth exact = {IKSTR_GROWTH_EXACT, 0, 0};
+    ikstr_growth geometric = {IKSTR_GROWTH_GEOMETRIC, 1.5, 0};
+
+    ikstr_set_growth(&exact);
+    ikstr s = ikstr_new("abc");
+    s = ikstr_concat(s, "def");
+    print_ikstr("exact growth", s);
+
+    ikstr_set_growth(&geometric);
+    for (int i = 0; i < 3; ++i) s = ikstr_concat(s, "ghi");
+    print_ikstr("geometric x1.5", s);
+    ikstr_set_growth(NULL);
+
+    s = ikstr_reserve(s, 300); // exact, and moves to a 16-bit header
+    print_ikstr("reserve(300)", s);
+    s = ikstr_shrink_to_fit(s);
+    print_ikstr("shrink_to_fit", s);
+
+    ikstr_free(s);
+
+    // Widest header from the start: crossing 255 bytes needs no migration
+    ikstr g = ikstr_new_growable("log:");
+    int type = g[-1] & IKSTR_TYPE_MASK;
+    for (int i = 0; i < 100; ++i) g = ikstr_concat(g, " ok");
+    printf("growable len=%zu, same header type: %d\n", ikstr_len(g), (g[-1] & IKSTR_TYPE_MASK) == type);
+    ikstr_free(g);
+}
+
+/**
+ * Demonstrates ikstr_arena: arena-backed creation, in-place growth and bulk reset.
+ */
+void ex_arena(void) {
+    ikstr_arena *arena = ikstr_arena_create(0);
+
+    ikstr a = ikstr_arena_new(arena, "GET");
+    ikstr b = ikstr_arena_new(arena, "/index");
+    b = ikstr_arena_concat(arena, b, ".html"); // last allocation: grows in place
+    a = ikstr_arena_concat(arena, a, " ");     // not the last one: bump-allocated copy
+    a = ikstr_arena_concat_ikstr(arena, a, b);
+    print_ikstr("arena a", a);
+    print_ikstr("arena b", b);
+    printf("cmp(a,b) = %d\n", ikstr_cmp(a, b) > 0);
+    ikstr_free(a); // no-op for arena strings
+
+    ikstr heap = ikstr_dup(b); // regular heap copy, outlives the arena
+    heap = ikstr_concat(heap, "?page=1");
+    ikstr spilled = ikstr_concat(b, "#section-two"); // no room left: moved to the heap
+    print_ikstr("spilled", spilled);
+    ikstr_free(spilled);
+    printf("arena used before reset = %zu\n", ikstr_arena_used(arena));
+    ikstr_arena_reset(arena);
+    printf("arena used after reset = %zu\n", ikstr_arena_used(arena));
+
+    print_ikstr("heap copy", heap);
+    ikstr_free(heap);
+    ikstr_arena_destroy(arena);
+}
+
+/**
+ * Demonstrates ikstr_small: a stack-resident string that spills to the heap on demand.
+ */
+void ex_small(void) {
+    ikstr_small buf;
+    ikstr s = ikstr_small_new(&buf, "  key=value  ");
+    printf("inline: %d\n", s >= buf.buf && s < buf.buf + sizeof(buf.buf));
+
+    s = ikstr_trim(s, " ");
+    print_ikstr("small trimmed", s);
+
+    int count = 0;
+    ikstr *kv = ikstr_split_len(s, (ssize_t)ikstr_len(s), "=", 1, &count);
+    printf("small split count=%d, first=%s\n", count, count ? kv[0] : "");
+    ikstr_free_split_res(kv, count);
+
+    for (int i = 0; i < 6; ++i) s = ikstr_concat(s, "&more=values");
+    printf("inline: %d\n", s >= buf.buf && s < buf.buf + sizeof(buf.buf));
+    print_ikstr("small spilled", s);
+    ikstr_free(s); // frees the heap copy; would be a no-op while inline
+}
+
+/**
+ * Demonstrates ikstr_view, ikstr_split_view and the view-aware cmp/trim/find.
+ */
+void ex_views(void) {
+    const char *line = "2025-10-22 | INFO  |  worker-3 | request done ";
+    ikstr_view fields[8];
+    size_t n = ikstr_split_view(line, strlen(line), "|", 1, fields, 8);
+
+    printf("split_view count=%zu\n", n);
+    for (size_t i = 0; i < n && i < 8; ++i) {
+        ikstr_view f = ikstr_view_trim(fields[i], " ");
+        printf("field %zu: \"%.*s\"\n", i, (int)f.len, f.ptr);
+    }
+
+    ikstr_view level = ikstr_view_trim(fields[1], " ");
+    printf("view_cmp(level, \"INFO\") = %d\n", ikstr_view_cmp(level, ikstr_view_cstr("INFO")));
+    printf("view_find(line, \"worker\") = %zd\n",
+           ikstr_view_find(ikstr_view_cstr(line), ikstr_view_cstr("worker")));
+    printf("view_find(line, \"ERROR\") = %zd\n",
+           ikstr_view_find(ikstr_view_cstr(line), ikstr_view_cstr("ERROR")));
+
+    printf("split_view count with max=2: %zu\n", ikstr_split_view(line, strlen(line), " | ", 3, fields, 2));
+
+    ikstr owned = ikstr_new_view(ikstr_view_trim(fields[2], " "));
+    print_ikstr("owned copy", owned);
+    ikstr_free(owned);
+}
+
+/**
+ * Demonstrates ikstr_split_iter over a whole buffer and over chunked input.
+ */
+void ex_split_iter(void) {
+    ikstr_split_iter it;
+    ikstr_view tok;
+
+    ikstr_split_iter_init(&it, "a::bb::ccc::", 12, "::", 2);
+    while (ikstr_split_iter_next(&it, &tok) == 1)
+        printf("iter token: \"%.*s\"\n", (int)tok.len, tok.ptr);
+    ikstr_split_iter_free(&it);
+
+    // The separator "::" and the token "gamma" straddle chunk boundaries
+    const char *chunks[] = {"alpha::be", "ta:", ":gam", "ma::delta"};
+    ikstr_split_iter_init_stream(&it, "::", 2);
+    for (size_t i = 0; i <= sizeof(chunks) / sizeof(chunks[0]); ++i) {
+        if (i < sizeof(chunks) / sizeof(chunks[0])) ikstr_split_iter_feed(&it, chunks[i], strlen(chunks[i]));
+        else ikstr_split_iter_finish(&it);
+        while (ikstr_split_iter_next(&it, &tok) == 1)
+            printf("stream token: \"%.*s\"\n", (int)tok.len, tok.ptr);
+    }
+    ikstr_split_iter_free(&it);
+}
+
+/**
+ * Allocation counters used by the tracking allocator below.
+ */
+struct alloc_stats {
+    size_t allocs, resizes, frees, sized_frees, live_bytes;
+};
+
+static void *tracking_alloc(void *ctx, size_t size) {
+    struct alloc_stats *st = ctx;
+    st->allocs++;
+    st->live_bytes += size;
+    return malloc(size);
+}
+
+static void *tracking_resize(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    struct alloc_stats *st = ctx;
+    st->resizes++;
+    st->live_bytes += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static void tracking_release(void *ctx, void *ptr) {
+    struct alloc_stats *st = ctx;
+    st->frees++;
+    free(ptr);
+}
+
+static void tracking_release_sized(void *ctx, void *ptr, size_t size) {
+    struct alloc_stats *st = ctx;
+    st->sized_frees++;
+    st->live_bytes -= size;
+    free(ptr);
+}
+
+/**
+ * Demonstrates ikstr_set_thread_allocator with a size-aware tracking allocator.
+ */
+void ex_allocator(void) {
+    struct alloc_stats st = {0};
+    ikstr_allocator tracker = {
+        tracking_alloc, tracking_resize, tracking_release, tracking_release_sized, &st, NULL
+    };
+
+    ikstr_set_thread_allocator(&tracker);
+    ikstr s = ikstr_new("tracked");
+    for (int i = 0; i < 100; ++i) s = ikstr_concat(s, "!");
+    print_ikstr("tracked", s);
+    ikstr_free(s);
+    ikstr_set_thread_allocator(NULL);
+
+    printf("allocs=%zu resizes=%zu frees=%zu sized_frees=%zu live_bytes=%zu\n",
+           st.allocs, st.resizes, st.frees, st.sized_frees, st.live_bytes);
+}
+
+/**
+ * Demonstrates the thread cache.
+ * - Short strings freed and created again reuse blocks from the cache of the
+ *   calling thread instead of going back to malloc.
+ */
+void ex_tcache(void) {
+    ikstr_tcache_config cfg = {NULL, 0, 16};
+    const ikstr_allocator *tc = ikstr_tcache_init(&cfg);
+    ikstr_tcache_stats st;
+    ikstr s[32];
+
+    if (NULL == tc) return;
+    ikstr_set_thread_allocator(tc);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 32; ++i) s[i] = ikstr_new("request");
+        for (int i = 0; i < 32; ++i) ikstr_free(s[i]);
+    }
+    ikstr_tcache_get_stats(&st);
+    printf("hits=%zu misses=%zu frees=%zu overflows=%zu cached=%zu\n",
+           st.hits, st.misses, st.frees, st.overflows, st.cached);
+
+    ikstr_tcache_flush(); // the cached blocks belong to malloc again
+    ikstr_set_thread_allocator(NULL);
+}
+
+/**
+ * Demonstrates ikstr_stats_snapshot.
+ * - The activity of a piece of code is the difference between two snapshots.
+ *   Counters are only kept when the library is built with IKSTR_STATS.
+ */
+void ex_stats(void) {
+    ikstr_stats before, after;
+    ikstr s;
+
+    if (ikstr_stats_snapshot(&before) != 0) {
+        printf("stats: not compiled in\n");
+        return;
+    }
+    s = ikstr_new("header");
+    for (int i = 0; i < 100; ++i) s = ikstr_concat(s, "0123456789");
+    ikstr_free(s);
+    ikstr_stats_snapshot(&after);
+
+    printf("allocs=%zu reallocs=%zu frees=%zu migrations=%zu bytes_copied=%zu\n",
+           after.allocs - before.allocs, after.reallocs - before.reallocs, after.frees - before.frees,
+           after.migrations - before.migrations, after.bytes_copied - before.bytes_copied);
+    printf("concat calls=%zu, make_room calls=%zu, slack handed out=%zu\n",
+           after.calls[IKSTR_CALL_CONCAT] - before.calls[IKSTR_CALL_CONCAT],
+           after.calls[IKSTR_CALL_MAKE_ROOM] - before.calls[IKSTR_CALL_MAKE_ROOM],
+           after.slack_bytes - before.slack_bytes);
+}
+
 /**
  * Entry point to run all examples.
  */
@@ -266,11 +876,31 @@ int main(void) {
     ex_copy_variants();
     ex_formatting();
     ex_trim();
+    ex_shared();
+    ex_intern();
+    ex_hash();
+    ex_map();
+    ex_rope();
+    ex_builder();
+    ex_map_file();
+    ex_io();
+    ex_line_reader();
     ex_range();
     ex_compare();
+    ex_find();
+    ex_matcher();
     ex_split_and_free();
+    ex_batch();
     ex_join_cstr();
     ex_join_ikstr();
     ex_make_room_for();
+    ex_growth();
+    ex_arena();
+    ex_small();
+    ex_views();
+    ex_split_iter();
+    ex_allocator();
+    ex_tcache();
+    ex_stats();
     return 0;
 }